@@ -35,11 +35,60 @@ struct Metadata
 };
 
 using CallbackType = std::function<void(const uint8_t *data, uint16_t size, const Metadata &metadata, const RemoteInfo &remote)>;
-#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
-using CallbackMap = std::map<uint16_t, CallbackType>;
-#else
-using CallbackMap = arx::stdx::map<uint16_t, CallbackType, FIXED_CONTAINER_CAPACITY>;
-#endif
+template <size_t N>
+using CallbackMap = FlatMap<uint16_t, CallbackType, N>;
+
+// Compile-time universe routing
+// Handler should have a static function like:
+// static void onArtDmx(const uint8_t *data, uint16_t size, const Metadata &metadata, const RemoteInfo &remote);
+template <uint16_t Universe, typename Handler>
+struct Route
+{
+};
+
+template <typename... Routes>
+struct RouteList;
+
+template <>
+struct RouteList<>
+{
+    static constexpr size_t size() { return 0; }
+
+    static bool dispatch(uint16_t, const uint8_t *, uint16_t, const Metadata &, const RemoteInfo &)
+    {
+        return false;
+    }
+
+    template <typename UniverseMap>
+    static void collectUniverses(UniverseMap &)
+    {
+    }
+};
+
+// NOTE: If the same universe is routed more than once, only the first route is called
+template <uint16_t Universe, typename Handler, typename... Tail>
+struct RouteList<Route<Universe, Handler>, Tail...>
+{
+    static constexpr size_t size() { return 1 + sizeof...(Tail); }
+
+    // chained comparisons against constant universes are folded into a switch by the compiler
+    // and the handlers are called directly (no std::function, no map lookup)
+    static bool dispatch(uint16_t universe, const uint8_t *data, uint16_t size, const Metadata &metadata, const RemoteInfo &remote)
+    {
+        if (universe == Universe) {
+            Handler::onArtDmx(data, size, metadata, remote);
+            return true;
+        }
+        return RouteList<Tail...>::dispatch(universe, data, size, metadata, remote);
+    }
+
+    template <typename UniverseMap>
+    static void collectUniverses(UniverseMap &universes)
+    {
+        universes.insert(Universe, true);
+        RouteList<Tail...>::collectUniverses(universes);
+    }
+};
 
 inline Metadata generateMetadataFrom(const uint8_t *packet)
 {
@@ -83,5 +132,9 @@ inline void setDataTo(uint8_t *packet, const uint16_t ch, const uint8_t data)
 
 using ArtDmxMetadata = art_net::art_dmx::Metadata;
 using ArtDmxCallback = art_net::art_dmx::CallbackType;
+template <uint16_t Universe, typename Handler>
+using ArtDmxRoute = art_net::art_dmx::Route<Universe, Handler>;
+template <typename... Routes>
+using ArtDmxRoutes = art_net::art_dmx::RouteList<Routes...>;
 
 #endif // ARTNET_ARTDMX_H
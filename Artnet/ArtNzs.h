@@ -35,11 +35,8 @@ struct Metadata
 };
 
 using CallbackType = std::function<void(const uint8_t *data, uint16_t size, const Metadata &metadata, const RemoteInfo &remote)>;
-#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
-using CallbackMap = std::map<uint16_t, CallbackType>;
-#else
-using CallbackMap = arx::stdx::map<uint16_t, CallbackType, FIXED_CONTAINER_CAPACITY>;
-#endif
+template <size_t N>
+using CallbackMap = FlatMap<uint16_t, CallbackType, N>;
 
 inline Metadata generateMetadataFrom(const uint8_t *packet)
 {
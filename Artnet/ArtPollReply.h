@@ -79,6 +79,16 @@ struct Config
     uint8_t sw_in[4] {0};
 };
 
+// only these fields differ between the replies for each universe
+inline void setUniverseTo(Packet &r, uint16_t universe)
+{
+    r.net_sw = (universe >> 8) & 0x7F;
+    r.sub_sw = (universe >> 4) & 0x0F;
+    // https://github.com/hideakitai/ArtNet/issues/81
+    // https://github.com/hideakitai/ArtNet/issues/121
+    r.sw_out[0] = (universe >> 0) & 0x0F;
+}
+
 inline Packet generatePacketFrom(const IPAddress &my_ip, const uint8_t my_mac[6], uint16_t universe, const Config &metadata)
 {
     Packet r;
@@ -114,11 +124,7 @@ inline Packet generatePacketFrom(const IPAddress &my_ip, const uint8_t my_mac[6]
     memset(r.port_types, 0, 4);
     memset(r.good_input, 0, 4);
     memset(r.good_output, 0, 4);
-    r.net_sw = (universe >> 8) & 0x7F;
-    r.sub_sw = (universe >> 4) & 0x0F;
-    // https://github.com/hideakitai/ArtNet/issues/81
-    // https://github.com/hideakitai/ArtNet/issues/121
-    r.sw_out[0] = (universe >> 0) & 0x0F;
+    setUniverseTo(r, universe);
     for (size_t i = 0; i < 4; ++i) {
         r.sw_in[i] = metadata.sw_in[i] & 0x0F;
     }
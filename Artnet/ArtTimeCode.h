@@ -0,0 +1,152 @@
+#pragma once
+#ifndef ARTNET_ART_TIMECODE_H
+#define ARTNET_ART_TIMECODE_H
+
+#include "Common.h"
+#include <stdint.h>
+#include <stddef.h>
+
+namespace art_net {
+namespace art_timecode {
+
+enum Index : uint16_t
+{
+    ID = 0,
+    OP_CODE_L = 8,
+    OP_CODE_H = 9,
+    PROTOCOL_VER_H = 10,
+    PROTOCOL_VER_L = 11,
+    FILLER = 12,
+    STREAM_ID = 13,
+    FRAMES = 14,
+    SECONDS = 15,
+    MINUTES = 16,
+    HOURS = 17,
+    TYPE = 18,
+
+    PACKET_SIZE = 19,
+};
+
+enum class Type : uint8_t
+{
+    Film = 0,       // 24 fps
+    EBU = 1,        // 25 fps
+    DropFrame = 2,  // 29.97 fps (frames 0 and 1 are skipped at each minute except every 10th)
+    SMPTE = 3,      // 30 fps
+};
+
+struct Metadata
+{
+    uint8_t hours;
+    uint8_t minutes;
+    uint8_t seconds;
+    uint8_t frames;
+    Type type;
+    uint8_t stream_id;  // 0: master
+};
+
+using CallbackType = std::function<void(const Metadata &metadata, const RemoteInfo &remote)>;
+
+// nominal frames in a second (30 for DropFrame)
+inline uint8_t framesPerSecond(Type type)
+{
+    switch (type) {
+        case Type::Film: return 24;
+        case Type::EBU: return 25;
+        default: return 30;
+    }
+}
+
+// start of the frame in microseconds (DropFrame runs at 30000 / 1001 fps)
+// rounded up so that microsToFrames(framesToMicros(n)) == n
+inline uint64_t framesToMicros(uint32_t frames, Type type)
+{
+    if (type == Type::DropFrame) {
+        return (static_cast<uint64_t>(frames) * 1001000 + 29) / 30;
+    }
+    const uint32_t fps = framesPerSecond(type);
+    return (static_cast<uint64_t>(frames) * 1000000 + fps - 1) / fps;
+}
+
+inline uint32_t microsToFrames(uint64_t us, Type type)
+{
+    if (type == Type::DropFrame) {
+        return static_cast<uint32_t>(us * 30 / 1001000);
+    }
+    return static_cast<uint32_t>(us * framesPerSecond(type) / 1000000);
+}
+
+// frames from 00:00:00:00
+inline uint32_t toFrameCount(const Metadata &tc)
+{
+    const uint32_t fps = framesPerSecond(tc.type);
+    const uint32_t total_minutes = 60 * static_cast<uint32_t>(tc.hours) + tc.minutes;
+    uint32_t count = (3600 * static_cast<uint32_t>(tc.hours) + 60 * static_cast<uint32_t>(tc.minutes) + tc.seconds) * fps + tc.frames;
+    if (tc.type == Type::DropFrame) {
+        count -= 2 * (total_minutes - total_minutes / 10);
+    }
+    return count;
+}
+
+inline Metadata fromFrameCount(uint32_t count, Type type, uint8_t stream_id = 0)
+{
+    const uint32_t fps = framesPerSecond(type);
+    if (type == Type::DropFrame) {
+        // 17982 frames in 10 minutes, 1798 frames in the minutes which drop 2 frames
+        const uint32_t tens = count / 17982;
+        const uint32_t rest = count % 17982;
+        count += 18 * tens + (rest >= 2 ? 2 * ((rest - 2) / 1798) : 0);
+    }
+    Metadata tc;
+    tc.frames = static_cast<uint8_t>(count % fps);
+    tc.seconds = static_cast<uint8_t>((count / fps) % 60);
+    tc.minutes = static_cast<uint8_t>((count / (fps * 60)) % 60);
+    tc.hours = static_cast<uint8_t>((count / (fps * 3600)) % 24);
+    tc.type = type;
+    tc.stream_id = stream_id;
+    return tc;
+}
+
+inline Metadata generateMetadataFrom(const uint8_t *packet)
+{
+    Metadata metadata;
+    metadata.hours = packet[HOURS];
+    metadata.minutes = packet[MINUTES];
+    metadata.seconds = packet[SECONDS];
+    metadata.frames = packet[FRAMES];
+    metadata.type = static_cast<Type>(packet[TYPE] & 0x03);
+    metadata.stream_id = packet[STREAM_ID];
+    return metadata;
+}
+
+inline bool isValid(const Metadata &tc)
+{
+    return tc.hours < 24 && tc.minutes < 60 && tc.seconds < 60 && tc.frames < framesPerSecond(tc.type);
+}
+
+inline void setDataTo(uint8_t *packet, const Metadata &tc)
+{
+    for (size_t i = 0; i < ID_LENGTH; i++) {
+        packet[i] = static_cast<uint8_t>(ARTNET_ID[i]);
+    }
+    packet[OP_CODE_L] = (static_cast<uint16_t>(OpCode::TimeCode) >> 0) & 0x00FF;
+    packet[OP_CODE_H] = (static_cast<uint16_t>(OpCode::TimeCode) >> 8) & 0x00FF;
+    packet[PROTOCOL_VER_H] = (PROTOCOL_VER >> 8) & 0x00FF;
+    packet[PROTOCOL_VER_L] = (PROTOCOL_VER >> 0) & 0x00FF;
+    packet[FILLER] = 0;
+    packet[STREAM_ID] = tc.stream_id;
+    packet[FRAMES] = tc.frames;
+    packet[SECONDS] = tc.seconds;
+    packet[MINUTES] = tc.minutes;
+    packet[HOURS] = tc.hours;
+    packet[TYPE] = static_cast<uint8_t>(tc.type);
+}
+
+} // namespace art_timecode
+} // namespace art_net
+
+using ArtTimeCodeCallback = art_net::art_timecode::CallbackType;
+using ArtTimeCodeMetadata = art_net::art_timecode::Metadata;
+using ArtTimeCodeType = art_net::art_timecode::Type;
+
+#endif // ARTNET_ART_TIMECODE_H
@@ -0,0 +1,168 @@
+#pragma once
+#ifndef ARTNET_CAPTURE_H
+#define ARTNET_CAPTURE_H
+
+#include "Common.h"
+#if ARTNET_ENABLE_CAPTURE
+#include <atomic>
+#endif
+
+namespace art_net {
+
+enum class CaptureDirection : uint8_t
+{
+    Received,  // accepted by Receiver_ (after the source filter)
+    Sent,      // sent by Sender_ (and ArtPollReply by Receiver_)
+};
+
+// header of a captured datagram
+struct CaptureRecord
+{
+    uint32_t timestamp_us;  // Clock<S>::micros() (wraps around)
+    uint8_t ip[4];          // remote address
+    uint16_t port;          // remote port
+    uint16_t size;          // bytes of the datagram
+    CaptureDirection direction;
+    uint8_t reserved[3];
+};
+
+inline CaptureRecord makeCaptureRecord(CaptureDirection direction, const IPAddress &ip, uint16_t port, uint32_t timestamp_us, size_t size)
+{
+    CaptureRecord record {};
+    record.timestamp_us = timestamp_us;
+    for (size_t i = 0; i < 4; ++i) {
+        record.ip[i] = ip[i];
+    }
+    record.port = port;
+    record.size = static_cast<uint16_t>(size);
+    record.direction = direction;
+    return record;
+}
+
+// Sender_ has the destination as String: "a.b.c.d" to the bytes of the address (0.0.0.0 if it is a host name)
+inline void parseCaptureAddress(const char *str, uint8_t ip[4])
+{
+    uint16_t octets[4] {0, 0, 0, 0};
+    size_t n = 0;
+    bool valid = true;
+    for (const char *c = str; *c && valid; ++c) {
+        if (*c >= '0' && *c <= '9') {
+            octets[n] = octets[n] * 10 + (*c - '0');
+            valid = octets[n] <= 255;
+        } else if (*c == '.' && n < 3) {
+            ++n;
+        } else {
+            valid = false;
+        }
+    }
+    valid = valid && n == 3;
+    for (size_t i = 0; i < 4; ++i) {
+        ip[i] = valid ? static_cast<uint8_t>(octets[i]) : 0;
+    }
+}
+
+#if ARTNET_ENABLE_CAPTURE
+
+// Destination of the datagrams copied by setCaptureSink() of Sender_ / Receiver_
+// capture() is called on the hot path, so it should only copy the datagram and never block
+struct ICaptureSink
+{
+    virtual ~ICaptureSink() = default;
+    virtual void capture(const CaptureRecord &record, const uint8_t *data) = 0;
+};
+
+// Preallocated ring of captured datagrams (e.g. drained to a pcap file by host::PcapCaptureWriter)
+// - capture() never blocks: if the ring is full, or another thread is writing at the same time, the datagram is dropped and counted
+// - any number of producers (Sender / Receiver on different threads), single consumer (read())
+// Size: bytes of the ring (power of 2), each datagram uses sizeof(CaptureRecord) + its size
+template <size_t Size = 16384>
+class CaptureRing : public ICaptureSink
+{
+    static_assert(Size >= 1024 && (Size & (Size - 1)) == 0, "Size of CaptureRing should be a power of 2 (>= 1024)");
+
+    uint8_t buffer[Size];
+    std::atomic<size_t> head {0};
+    std::atomic<size_t> tail {0};
+    std::atomic_flag writing = ATOMIC_FLAG_INIT;
+    std::atomic<uint32_t> num_captured {0};
+    std::atomic<uint32_t> num_dropped {0};
+
+public:
+    void capture(const CaptureRecord &record, const uint8_t *data) override
+    {
+        // producers are serialized without waiting (the loser drops its datagram)
+        if (this->writing.test_and_set(std::memory_order_acquire)) {
+            this->num_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const size_t h = this->head.load(std::memory_order_relaxed);
+        const size_t used = h - this->tail.load(std::memory_order_acquire);
+        const size_t need = sizeof(CaptureRecord) + record.size;
+        if (need > Size - used) {
+            this->num_dropped.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            this->copyIn(h, reinterpret_cast<const uint8_t *>(&record), sizeof(CaptureRecord));
+            this->copyIn(h + sizeof(CaptureRecord), data, record.size);
+            this->head.store(h + need, std::memory_order_release);
+            this->num_captured.fetch_add(1, std::memory_order_relaxed);
+        }
+        this->writing.clear(std::memory_order_release);
+    }
+
+    /// @brief Take the oldest datagram (consumer)
+    /// @param data buffer for the datagram (the datagram is truncated to max_size, record.size is not changed)
+    /// @return false if the ring is empty
+    bool read(CaptureRecord &record, uint8_t *data, size_t max_size)
+    {
+        const size_t t = this->tail.load(std::memory_order_relaxed);
+        if (t == this->head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        this->copyOut(t, reinterpret_cast<uint8_t *>(&record), sizeof(CaptureRecord));
+        this->copyOut(t + sizeof(CaptureRecord), data, record.size < max_size ? record.size : max_size);
+        this->tail.store(t + sizeof(CaptureRecord) + record.size, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return this->tail.load(std::memory_order_acquire) == this->head.load(std::memory_order_acquire);
+    }
+
+    // number of datagrams accepted into the ring
+    uint32_t captured() const
+    {
+        return this->num_captured.load(std::memory_order_relaxed);
+    }
+
+    // number of datagrams dropped because the ring was full (or busy)
+    uint32_t dropped() const
+    {
+        return this->num_dropped.load(std::memory_order_relaxed);
+    }
+
+    static constexpr size_t capacity() { return Size; }
+
+private:
+    void copyIn(size_t pos, const uint8_t *src, size_t size)
+    {
+        const size_t i = pos & (Size - 1);
+        const size_t first = size < Size - i ? size : Size - i;
+        memcpy(this->buffer + i, src, first);
+        memcpy(this->buffer, src + first, size - first);
+    }
+
+    void copyOut(size_t pos, uint8_t *dst, size_t size) const
+    {
+        const size_t i = pos & (Size - 1);
+        const size_t first = size < Size - i ? size : Size - i;
+        memcpy(dst, this->buffer + i, first);
+        memcpy(dst + first, this->buffer, size - first);
+    }
+};
+
+#endif
+
+} // namespace art_net
+
+#endif // ARTNET_CAPTURE_H
@@ -0,0 +1,36 @@
+#pragma once
+#ifndef ARTNET_CLOCK_H
+#define ARTNET_CLOCK_H
+
+#include "Common.h"
+
+namespace art_net {
+
+// Time and random numbers used by Sender_ / Receiver_ of the stream type S
+// (streaming interval, ArtPollReply scheduling, statistics and receive timestamps)
+// Specialize it for the stream type to simulate time faster than real time (e.g. LoopbackUDP with virtual time)
+// NOTE: values wrap around like millis() / micros(), so compare them only by elapsed() / isDue()
+template <typename S>
+struct Clock
+{
+    static uint32_t millis() { return ::millis(); }
+    static uint32_t micros() { return ::micros(); }
+    // [0, max)
+    static long random(long max) { return ::random(max); }
+};
+
+// time from `since` to `now` which is correct across the wraparound (if less than 2^32 apart)
+inline uint32_t elapsed(uint32_t now, uint32_t since)
+{
+    return now - since;
+}
+
+// true if `wait` has passed since `since` (NOT `now >= since + wait`, which is wrong after the wraparound)
+inline bool isDue(uint32_t now, uint32_t since, uint32_t wait)
+{
+    return elapsed(now, since) >= wait;
+}
+
+} // namespace art_net
+
+#endif // ARTNET_CLOCK_H
@@ -0,0 +1,149 @@
+#pragma once
+#ifndef ARTNET_COALESCING_RECEIVER_H
+#define ARTNET_COALESCING_RECEIVER_H
+
+#include "Receiver.h"
+
+namespace art_net {
+
+// Receiver which drains the backlog of the socket and dispatches only the newest ArtDmx / ArtNzs per universe
+// - after a stall of loop() (flash write, WiFi reconnect, etc.), drain() reads all queued datagrams
+//   and keeps the newest packet of each universe and source (by arrival order, and by sequence if it is enabled).
+//   Packets from different sources are never merged because their sequences are unrelated (e.g. two consoles for HTP)
+// - other packets (ArtSync, ArtTrigger, ArtPoll, etc.) are dispatched in order: the packets kept
+//   before them are dispatched first, so ArtSync still comes after the data of its frame
+// - packets replaced by newer ones are not dispatched and counted by coalesced()
+// Slots: max number of universes (per source) kept at once (PACKET_SIZE bytes each, plus one for reading).
+//        If more universes arrive, the kept packets are dispatched before the new one is kept.
+template <typename S, size_t Slots = 4, size_t MaxUniverses = DEFAULT_MAX_UNIVERSES, typename Routes = art_dmx::RouteList<>>
+class CoalescingReceiver : public Receiver<S, MaxUniverses, Routes>
+{
+    static_assert(Slots >= 1 && Slots < 255, "Slots of CoalescingReceiver should be 1 - 254");
+
+    struct Slot
+    {
+        uint32_t key;  // (OpCode << 16) | universe, or 0 if the packet is not coalesced
+        uint16_t size;
+        RemoteInfo remote;
+        uint8_t data[PACKET_SIZE];
+    };
+
+    Slot slots[Slots + 1];
+    // slots[order[0 .. num_pending)] are kept in arrival order, slots[order[num_pending]] is for the next read
+    uint8_t order[Slots + 1];
+    size_t num_pending {0};
+    uint32_t num_coalesced {0};
+
+public:
+    CoalescingReceiver()
+    {
+        for (size_t i = 0; i < Slots + 1; ++i) {
+            this->order[i] = static_cast<uint8_t>(i);
+        }
+    }
+
+    /// @brief Read the queued datagrams, coalesce them per universe, and run the callbacks
+    /// @param max_packets max number of datagrams to read in this call
+    /// @return number of datagrams read from the stream (including coalesced ones)
+    size_t drain(size_t max_packets = 256)
+    {
+        size_t n = 0;
+        for (; n < max_packets; ++n) {
+            Slot &slot = this->slots[this->order[this->num_pending]];
+            const size_t size = this->receiveRaw(slot.data, PACKET_SIZE, slot.remote);
+            if (size == 0) {
+                break;
+            }
+            slot.size = static_cast<uint16_t>(size);
+            slot.key = keyOf(slot.data, size);
+
+            if (slot.key == 0) {
+                // keep the order of the packets which are not coalesced
+                this->flush();
+                this->parse(slot.data, slot.size, slot.remote);
+                continue;
+            }
+
+            size_t i = 0;
+            while (i < this->num_pending && !isSameStream(this->slots[this->order[i]], slot)) {
+                ++i;
+            }
+            if (i < this->num_pending) {
+                // replace the kept packet unless the new one is older in sequence (reordered by the network)
+                if (isNewer(slot.data, this->slots[this->order[i]].data)) {
+                    const uint8_t replaced = this->order[i];
+                    this->order[i] = this->order[this->num_pending];
+                    this->order[this->num_pending] = replaced;
+                }
+                ++this->num_coalesced;
+            } else if (this->num_pending < Slots) {
+                ++this->num_pending;
+            } else {
+                this->flush();
+                const uint8_t next = this->order[0];
+                this->order[0] = this->order[Slots];
+                this->order[Slots] = next;
+                this->num_pending = 1;
+            }
+        }
+        this->flush();
+        this->update();
+        return n;
+    }
+
+    // number of packets which were replaced by newer ones and not dispatched
+    uint32_t coalesced() const
+    {
+        return this->num_coalesced;
+    }
+
+    static constexpr size_t capacity()
+    {
+        return Slots;
+    }
+
+private:
+    // dispatch the kept packets in arrival order
+    void flush()
+    {
+        for (size_t i = 0; i < this->num_pending; ++i) {
+            const Slot &slot = this->slots[this->order[i]];
+            this->parse(slot.data, slot.size, slot.remote);
+        }
+        this->num_pending = 0;
+    }
+
+    // same universe from the same source
+    static bool isSameStream(const Slot &kept, const Slot &slot)
+    {
+        return kept.key == slot.key && kept.remote.ip == slot.remote.ip;
+    }
+
+    static uint32_t keyOf(const uint8_t *data, size_t size)
+    {
+        if (size <= art_dmx::DATA || memcmp(data, ARTNET_ID, sizeof(ARTNET_ID)) != 0) {
+            return 0;
+        }
+        const uint16_t op_code = (data[art_dmx::OP_CODE_H] << 8) | data[art_dmx::OP_CODE_L];
+        if (op_code != static_cast<uint16_t>(OpCode::Dmx) && op_code != static_cast<uint16_t>(OpCode::Nzs)) {
+            return 0;
+        }
+        const uint16_t universe = (data[art_dmx::NET] << 8) | data[art_dmx::SUBUNI];
+        return ((uint32_t)op_code << 16) | universe;
+    }
+
+    // sequence 0 means disabled, otherwise compare within the half of the 8 bit range
+    static bool isNewer(const uint8_t *data, const uint8_t *kept)
+    {
+        const uint8_t seq = data[art_dmx::SEQUENCE];
+        const uint8_t kept_seq = kept[art_dmx::SEQUENCE];
+        if (seq == 0 || kept_seq == 0) {
+            return true;
+        }
+        return static_cast<int8_t>(seq - kept_seq) >= 0;
+    }
+};
+
+} // namespace art_net
+
+#endif // ARTNET_COALESCING_RECEIVER_H
@@ -4,8 +4,11 @@
 
 #include <ArxTypeTraits.h>
 #include <ArxContainer.h>
+#include "Config.h"
+#include "FlatMap.h"
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
 namespace art_net {
 // Packet Summary : https://art-net.org.uk/structure/packet-summary-2/
@@ -48,6 +51,7 @@ enum class OpCode : uint16_t {
     FileFnReply = 0xF600,
     // Others
     NoPacket = 0x0000,
+    Filtered = 0xFFFD,  // dropped by the source filter
     Unsupported = 0xFFFE,
     ParseFailed = 0xFFFF,
 };
@@ -72,27 +76,112 @@ template <uint16_t SIZE, typename T = uint8_t>
 using Array = arx::stdx::vector<T, SIZE>;
 #endif
 
+// Default capacities of the subscription / destination tables
+// They can be overridden by template parameters (e.g. Receiver<S, MaxUniverses>, Sender<S, MaxDestinations>)
+// or globally by defining these macros before including the library
+#ifndef ARTNET_DEFAULT_MAX_UNIVERSES
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+#define ARTNET_DEFAULT_MAX_UNIVERSES 64
+#else
+#define ARTNET_DEFAULT_MAX_UNIVERSES FIXED_CONTAINER_CAPACITY
+#endif
+#endif
+#ifndef ARTNET_DEFAULT_MAX_DESTINATIONS
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+#define ARTNET_DEFAULT_MAX_DESTINATIONS 64
+#else
+#define ARTNET_DEFAULT_MAX_DESTINATIONS FIXED_CONTAINER_CAPACITY
+#endif
+#endif
+#ifndef ARTNET_DEFAULT_MAX_SOURCE_FILTERS
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
+#define ARTNET_DEFAULT_MAX_SOURCE_FILTERS 16
+#else
+#define ARTNET_DEFAULT_MAX_SOURCE_FILTERS FIXED_CONTAINER_CAPACITY
+#endif
+#endif
+constexpr size_t DEFAULT_MAX_UNIVERSES {ARTNET_DEFAULT_MAX_UNIVERSES};
+constexpr size_t DEFAULT_MAX_DESTINATIONS {ARTNET_DEFAULT_MAX_DESTINATIONS};
+constexpr size_t DEFAULT_MAX_SOURCE_FILTERS {ARTNET_DEFAULT_MAX_SOURCE_FILTERS};
+
+// Last writer of a packet buffer shared by Sender_ and Receiver_
+enum class PacketOwner : uint8_t
+{
+    None,
+    Sender,    // data staged by setArtDmxData() / setArtNzsData()
+    Receiver,  // received datagram
+};
+
+// Non-owning reference to the packet buffer used by Sender_ / Receiver_
+// The buffer itself is owned by Sender / Receiver / Manager so that Manager can share one buffer
+// If the buffer is shared, the owner tag is shared too, so that the sender can detect that parse() overwrote its data
+class PacketRef
+{
+    uint8_t *buffer {nullptr};
+    PacketOwner *owner {nullptr};  // nullptr if the buffer is not shared
+
+public:
+    void attach(uint8_t *b, PacketOwner *o = nullptr)
+    {
+        this->buffer = b;
+        this->owner = o;
+    }
+    void claim(PacketOwner o)
+    {
+        if (this->owner) {
+            *this->owner = o;
+        }
+    }
+    bool ownedBy(PacketOwner o) const { return !this->owner || *this->owner == o; }
+    uint8_t *data() { return this->buffer; }
+    const uint8_t *data() const { return this->buffer; }
+    size_t size() const { return PACKET_SIZE; }
+    uint8_t &operator[](size_t i) { return this->buffer[i]; }
+    const uint8_t &operator[](size_t i) const { return this->buffer[i]; }
+};
+
+enum class PacketBufferMode : uint8_t
+{
+    Separate,  // Sender and Receiver have their own packet buffer (default)
+    Shared,    // Sender and Receiver share one packet buffer (saves PACKET_SIZE bytes)
+};
+
 struct RemoteInfo
 {
     IPAddress ip;
     uint16_t port;
+    uint32_t received_us;  // micros() when the packet was received (monotonic, wraps around)
 };
 
+// max length of the ip of a destination ("255.255.255.255")
+constexpr size_t DESTINATION_IP_LENGTH {15};
+
+// the ip is copied into the entry, so registering a destination doesn't allocate
 struct Destination
 {
-    String ip;
+    char ip[DESTINATION_IP_LENGTH + 1];
     uint8_t net;
     uint8_t subnet;
     uint8_t universe;
 };
 
+// Lightweight key to look up a Destination without copying its ip
+struct DestinationKey
+{
+    const char *ip;
+    uint8_t net;
+    uint8_t subnet;
+    uint8_t universe;
+};
 
-inline bool operator<(const Destination &rhs, const Destination &lhs)
+template <typename Lhs, typename Rhs>
+inline bool lessDestination(const Lhs &rhs, const Rhs &lhs)
 {
-    if (rhs.ip < lhs.ip) {
+    const int ip = strcmp(rhs.ip, lhs.ip);
+    if (ip < 0) {
         return true;
     }
-    if (rhs.ip > lhs.ip) {
+    if (ip > 0) {
         return false;
     }
     if (rhs.net < lhs.net) {
@@ -116,20 +205,35 @@ inline bool operator<(const Destination &rhs, const Destination &lhs)
     return false;
 }
 
+inline bool operator<(const Destination &rhs, const Destination &lhs)
+{
+    return lessDestination(rhs, lhs);
+}
+inline bool operator<(const Destination &rhs, const DestinationKey &lhs)
+{
+    return lessDestination(rhs, lhs);
+}
+inline bool operator<(const DestinationKey &rhs, const Destination &lhs)
+{
+    return lessDestination(rhs, lhs);
+}
+
 inline bool operator==(const Destination &rhs, const Destination &lhs)
 {
-    return rhs.ip == lhs.ip && rhs.net == lhs.net && rhs.subnet == lhs.subnet && rhs.universe == lhs.universe;
+    return strcmp(rhs.ip, lhs.ip) == 0 && rhs.net == lhs.net && rhs.subnet == lhs.subnet && rhs.universe == lhs.universe;
 }
 
-#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
 // sender
-using LastSendTimeMsMap = std::map<Destination, double>;
-using SequenceMap = std::map<Destination, uint8_t>;
-#else
-// sender
-using LastSendTimeMsMap = arx::stdx::map<Destination, double, FIXED_CONTAINER_CAPACITY>;
-using SequenceMap = arx::stdx::map<Destination, uint8_t, FIXED_CONTAINER_CAPACITY>;
-#endif
+struct DestinationState
+{
+    uint32_t last_send_time_ms {0};
+    bool streamed {false};  // last_send_time_ms is valid
+    uint8_t dmx_sequence {0};
+    uint8_t nzs_sequence {0};
+};
+
+template <size_t N>
+using DestinationStateMap = FlatMap<Destination, DestinationState, N>;
 
 }  // namespace art_net
 
@@ -0,0 +1,112 @@
+#pragma once
+#ifndef ARTNET_CONFIG_H
+#define ARTNET_CONFIG_H
+
+// Compile-time feature selection
+// Define these macros as 0 before including the library (or by build flags like -DARTNET_ENABLE_ART_NZS=0)
+// to remove the opcode handlers, callbacks and APIs which are not used in your sketch.
+// e.g.)
+//   #define ARTNET_ENABLE_ART_NZS 0
+//   #define ARTNET_ENABLE_ART_TRIGGER 0
+//   #include <ArtnetEther.h>
+
+// ArtDmx (receive / send)
+#ifndef ARTNET_ENABLE_ART_DMX
+#define ARTNET_ENABLE_ART_DMX 1
+#endif
+
+// ArtNzs (receive / send)
+#ifndef ARTNET_ENABLE_ART_NZS
+#define ARTNET_ENABLE_ART_NZS 1
+#endif
+
+// ArtPoll (receive) and ArtPollReply (send)
+#ifndef ARTNET_ENABLE_ART_POLL_REPLY
+#define ARTNET_ENABLE_ART_POLL_REPLY 1
+#endif
+
+// ArtTrigger (receive / send)
+#ifndef ARTNET_ENABLE_ART_TRIGGER
+#define ARTNET_ENABLE_ART_TRIGGER 1
+#endif
+
+// ArtSync (receive / send)
+#ifndef ARTNET_ENABLE_ART_SYNC
+#define ARTNET_ENABLE_ART_SYNC 1
+#endif
+
+// ArtTimeCode (receive / send)
+#ifndef ARTNET_ENABLE_ART_TIMECODE
+#define ARTNET_ENABLE_ART_TIMECODE 1
+#endif
+
+// Forwarding ArtDmx to FastLED (only available if FastLED is included before this library)
+#ifndef ARTNET_ENABLE_FASTLED
+#if defined(FASTLED_VERSION)
+#define ARTNET_ENABLE_FASTLED ARTNET_ENABLE_ART_DMX
+#else
+#define ARTNET_ENABLE_FASTLED 0
+#endif
+#endif
+
+// Allow / deny list of source IP addresses checked before reading the payload (Receiver)
+#ifndef ARTNET_ENABLE_SOURCE_FILTER
+#define ARTNET_ENABLE_SOURCE_FILTER 1
+#endif
+
+// Counters of packets, bytes, drops and send failures (Receiver / Sender)
+#ifndef ARTNET_ENABLE_STATS
+#if defined(ARDUINO_ARCH_AVR)
+#define ARTNET_ENABLE_STATS 0
+#else
+#define ARTNET_ENABLE_STATS 1
+#endif
+#endif
+
+// Histograms of packet interval and callback latency for each universe (part of the statistics, opt-in)
+// It adds about 160 bytes for each of MaxUniverses (about 10 KB per receiver with the default 64 universes)
+#ifndef ARTNET_ENABLE_HISTOGRAMS
+#define ARTNET_ENABLE_HISTOGRAMS 0
+#endif
+
+// Trace points in the receive / send path recorded into a ring (see Artnet/Trace.h, for profiling)
+#ifndef ARTNET_ENABLE_TRACE
+#define ARTNET_ENABLE_TRACE 0
+#endif
+#ifndef ARTNET_TRACE_BUFFER_SIZE
+#define ARTNET_TRACE_BUFFER_SIZE 4096
+#endif
+
+// Copy of the sent / received datagrams to the sink set by setCaptureSink() (see Artnet/Capture.h)
+// CaptureRing needs <atomic>, so it is enabled only with libstdc++ (not on AVR / megaAVR)
+// NOTE: ARX_HAVE_LIBSTDCPLUSPLUS is defined by ArxTypeTraits which Common.h includes before this file
+#ifndef ARTNET_ENABLE_CAPTURE
+#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L
+#define ARTNET_ENABLE_CAPTURE 1
+#else
+#define ARTNET_ENABLE_CAPTURE 0
+#endif
+#endif
+
+// Log level of the messages printed to the logger set by setLogger()
+// Messages above the level are removed at compile time (e.g. per packet messages are DEBUG)
+#define ARTNET_LOG_LEVEL_NONE 0
+#define ARTNET_LOG_LEVEL_ERROR 1
+#define ARTNET_LOG_LEVEL_WARN 2
+#define ARTNET_LOG_LEVEL_INFO 3
+#define ARTNET_LOG_LEVEL_DEBUG 4
+#ifndef ARTNET_LOG_LEVEL
+#define ARTNET_LOG_LEVEL ARTNET_LOG_LEVEL_WARN
+#endif
+
+// Subscriptions can be updated from other threads/tasks while parse() is running (e.g. web UI task on ESP32)
+// Enabled by default on the platforms which have threads. It keeps 3 copies of the subscription table.
+#ifndef ARTNET_THREAD_SAFE_SUBSCRIPTIONS
+#if defined(ESP_PLATFORM) || !defined(ARDUINO)
+#define ARTNET_THREAD_SAFE_SUBSCRIPTIONS 1
+#else
+#define ARTNET_THREAD_SAFE_SUBSCRIPTIONS 0
+#endif
+#endif
+
+#endif  // ARTNET_CONFIG_H
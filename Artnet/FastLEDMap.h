@@ -0,0 +1,201 @@
+#pragma once
+#ifndef ARTNET_FASTLED_MAP_H
+#define ARTNET_FASTLED_MAP_H
+
+#include "Common.h"
+#include "Clock.h"
+
+#if ARTNET_ENABLE_FASTLED
+
+#include <string.h>
+
+namespace art_net {
+
+// capacity of the strips registered to a receiver (to be notified of ArtSync)
+constexpr size_t MAX_FASTLED_MAPS {8};
+
+// Strip of CRGB (FastLED) spread over consecutive universes
+// - universe start_universe + i has pixels_per_universe pixels from start_channel (0 origin) of the universe
+//   (170 pixels = 510 channels by default, and the rest of the universe is padding)
+// - pixels are copied by memcpy (CRGB is 3 bytes of r, g, b; reorder the colors by FastLED.addLeds<..., RGB_ORDER>)
+// - short packets fill only the pixels they have (counted in shortPackets(), not logged)
+// - the strip is ready when all of its universes are received, or on ArtSync once ArtSync is received
+//   (synchronous mode, and back to immediate mode if no ArtSync is received for 4 seconds as Art-Net 4 specifies)
+// e.g.)
+//   ArtDmxFastLEDMap strip(leds, 600, 1);  // universes 1 - 4
+//   artnet.forwardArtDmxDataToFastLED(strip);
+//   strip.onReady([] { FastLED.show(); });
+class FastLEDMap
+{
+public:
+    using CallbackType = std::function<void()>;
+
+    // max universes of a strip (bits of the received flags)
+    static constexpr uint16_t MAX_UNIVERSES {32};
+    static constexpr uint16_t DEFAULT_PIXELS_PER_UNIVERSE {170};
+    static constexpr uint32_t SYNC_TIMEOUT_US {4000000};
+
+private:
+    static_assert(sizeof(CRGB) == 3, "CRGB should be 3 bytes to be copied from ArtDmx data");
+
+    CRGB *leds;
+    uint16_t num_leds;
+    uint16_t start_universe;
+    uint16_t pixels_per_universe;
+    uint16_t start_channel;
+
+    uint32_t received_flags {0};
+    bool sync_mode {false};
+    uint32_t last_sync_us {0};
+    bool ready {false};
+    CallbackType callback;
+
+    uint32_t num_frames {0};
+    uint32_t num_incomplete_frames {0};
+    uint32_t num_short_packets {0};
+
+public:
+    FastLEDMap(CRGB *leds, uint16_t num_leds, uint16_t start_universe,
+               uint16_t pixels_per_universe = DEFAULT_PIXELS_PER_UNIVERSE, uint16_t start_channel = 0)
+    : leds(leds)
+    , num_leds(num_leds)
+    , start_universe(start_universe & 0x7FFF)
+    , pixels_per_universe(pixels_per_universe)
+    , start_channel(start_channel)
+    {
+    }
+
+    // pixels fit into a universe, and universes into the received flags
+    bool isValid() const
+    {
+        return this->leds && this->num_leds > 0 && this->pixels_per_universe > 0
+            && this->start_channel + 3 * static_cast<uint32_t>(this->pixels_per_universe) <= 512
+            && this->numUniverses() <= MAX_UNIVERSES
+            && this->start_universe + this->numUniverses() <= 0x8000;
+    }
+
+    uint16_t startUniverse() const
+    {
+        return this->start_universe;
+    }
+
+    uint16_t numUniverses() const
+    {
+        return this->pixels_per_universe == 0 ? 0 : (this->num_leds + this->pixels_per_universe - 1) / this->pixels_per_universe;
+    }
+
+    // called when the strip is ready to show (from the receiver, e.g. FastLED.show())
+    void onReady(const CallbackType &func)
+    {
+        this->callback = func;
+    }
+
+    // true after the strip got ready until clearReady() (to show it from loop())
+    bool isReady() const
+    {
+        return this->ready;
+    }
+
+    void clearReady()
+    {
+        this->ready = false;
+    }
+
+    // ArtSync has been received within the timeout
+    bool isSyncMode(uint32_t now_us) const
+    {
+        return this->sync_mode && !isDue(now_us, this->last_sync_us, SYNC_TIMEOUT_US);
+    }
+
+    // frames which got ready
+    uint32_t frames() const
+    {
+        return this->num_frames;
+    }
+
+    // frames restarted before all universes were received (lost universes)
+    uint32_t incompleteFrames() const
+    {
+        return this->num_incomplete_frames;
+    }
+
+    // packets with less channels than the pixels of the universe
+    uint32_t shortPackets() const
+    {
+        return this->num_short_packets;
+    }
+
+    // copy ArtDmx data of the index-th universe of the strip (called by the receiver)
+    void setArtDmxData(uint16_t index, const uint8_t *data, uint16_t size, uint32_t received_us)
+    {
+        if (index >= this->numUniverses()) {
+            return;
+        }
+        const uint32_t flag = 1UL << index;
+        if (this->received_flags & flag) {
+            // the same universe again before the frame is completed
+            ++this->num_incomplete_frames;
+            this->received_flags = 0;
+        }
+
+        const size_t offset = static_cast<size_t>(index) * this->pixels_per_universe;
+        size_t n = this->num_leds - offset;
+        if (n > this->pixels_per_universe) {
+            n = this->pixels_per_universe;
+        }
+        const size_t available = size > this->start_channel ? (size - this->start_channel) / 3 : 0;
+        if (available < n) {
+            ++this->num_short_packets;
+            n = available;
+        }
+        memcpy(reinterpret_cast<uint8_t *>(this->leds + offset), data + this->start_channel, 3 * n);
+
+        this->received_flags |= flag;
+        if (!this->updateSyncMode(received_us) && this->received_flags == this->allFlags()) {
+            this->complete();
+        }
+    }
+
+    // ArtSync is received (called by the receiver)
+    void sync(uint32_t received_us)
+    {
+        this->sync_mode = true;
+        this->last_sync_us = received_us;
+        if (this->received_flags != 0) {
+            this->complete();
+        }
+    }
+
+private:
+    bool updateSyncMode(uint32_t now_us)
+    {
+        if (this->sync_mode && isDue(now_us, this->last_sync_us, SYNC_TIMEOUT_US)) {
+            this->sync_mode = false;
+        }
+        return this->sync_mode;
+    }
+
+    uint32_t allFlags() const
+    {
+        const uint16_t n = this->numUniverses();
+        return n >= 32 ? 0xFFFFFFFFUL : (1UL << n) - 1;
+    }
+
+    void complete()
+    {
+        this->received_flags = 0;
+        this->ready = true;
+        ++this->num_frames;
+        if (this->callback) {
+            this->callback();
+        }
+    }
+};
+
+} // namespace art_net
+
+using ArtDmxFastLEDMap = art_net::FastLEDMap;
+
+#endif // ARTNET_ENABLE_FASTLED
+
+#endif // ARTNET_FASTLED_MAP_H
@@ -0,0 +1,160 @@
+#pragma once
+#ifndef ARTNET_FLAT_MAP_H
+#define ARTNET_FLAT_MAP_H
+
+#include <ArxTypeTraits.h>
+#include <stdint.h>
+#include <stddef.h>
+
+namespace art_net {
+
+// Fixed capacity map backed by a sorted array
+// - no heap allocation by the container itself (entries are stored inline)
+// - lookup is binary search, insert/erase shift (move) the entries after the position
+//   (so shifting std::function values doesn't allocate)
+// - Key needs operator< (heterogeneous lookup works if operator< is defined for both directions)
+template <typename Key, typename Value, size_t Capacity>
+class FlatMap
+{
+public:
+    struct Entry
+    {
+        Key first;
+        Value second;
+    };
+
+private:
+    Entry entries[Capacity];
+    size_t count {0};
+
+public:
+    static constexpr size_t capacity() { return Capacity; }
+    size_t size() const { return this->count; }
+    bool empty() const { return this->count == 0; }
+    bool full() const { return this->count >= Capacity; }
+
+    Entry *begin() { return this->entries; }
+    Entry *end() { return this->entries + this->count; }
+    const Entry *begin() const { return this->entries; }
+    const Entry *end() const { return this->entries + this->count; }
+
+    template <typename K>
+    Value *find(const K &key)
+    {
+        const size_t i = this->lowerBound(key);
+        if (i < this->count && !(key < this->entries[i].first)) {
+            return &this->entries[i].second;
+        }
+        return nullptr;
+    }
+
+    template <typename K>
+    const Value *find(const K &key) const
+    {
+        const size_t i = this->lowerBound(key);
+        if (i < this->count && !(key < this->entries[i].first)) {
+            return &this->entries[i].second;
+        }
+        return nullptr;
+    }
+
+    /// @brief Insert new entry or assign value to existing entry
+    /// @return pointer to the stored value, or nullptr if the map is full
+    Value *insert(const Key &key, const Value &value)
+    {
+        const size_t i = this->lowerBound(key);
+        if (i < this->count && !(key < this->entries[i].first)) {
+            this->entries[i].second = value;
+            return &this->entries[i].second;
+        }
+        if (this->full()) {
+            return nullptr;
+        }
+        for (size_t j = this->count; j > i; --j) {
+            this->entries[j] = std::move(this->entries[j - 1]);
+        }
+        this->entries[i].first = key;
+        this->entries[i].second = value;
+        ++this->count;
+        return &this->entries[i].second;
+    }
+
+    template <typename K>
+    bool erase(const K &key)
+    {
+        const size_t i = this->lowerBound(key);
+        if (i >= this->count || key < this->entries[i].first) {
+            return false;
+        }
+        for (size_t j = i; j + 1 < this->count; ++j) {
+            this->entries[j] = std::move(this->entries[j + 1]);
+        }
+        --this->count;
+        // release resources held by the vacated entry (e.g. captures of std::function)
+        this->entries[this->count] = Entry();
+        return true;
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i < this->count; ++i) {
+            this->entries[i] = Entry();
+        }
+        this->count = 0;
+    }
+
+private:
+    template <typename K>
+    size_t lowerBound(const K &key) const
+    {
+        size_t lo = 0;
+        size_t hi = this->count;
+        while (lo < hi) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (this->entries[mid].first < key) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+};
+
+// Capacity 0 (e.g. no runtime subscriptions): always empty, and no storage
+template <typename Key, typename Value>
+class FlatMap<Key, Value, 0>
+{
+public:
+    struct Entry
+    {
+        Key first;
+        Value second;
+    };
+
+    static constexpr size_t capacity() { return 0; }
+    size_t size() const { return 0; }
+    bool empty() const { return true; }
+    bool full() const { return true; }
+
+    Entry *begin() { return nullptr; }
+    Entry *end() { return nullptr; }
+    const Entry *begin() const { return nullptr; }
+    const Entry *end() const { return nullptr; }
+
+    template <typename K>
+    Value *find(const K &) { return nullptr; }
+    template <typename K>
+    const Value *find(const K &) const { return nullptr; }
+
+    Value *insert(const Key &, const Value &) { return nullptr; }
+
+    template <typename K>
+    bool erase(const K &) { return false; }
+
+    void clear() {}
+};
+
+} // namespace art_net
+
+#endif // ARTNET_FLAT_MAP_H
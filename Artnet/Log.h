@@ -0,0 +1,60 @@
+#pragma once
+#ifndef ARTNET_LOG_H
+#define ARTNET_LOG_H
+
+#include "Common.h"
+
+namespace art_net {
+
+enum class LogLevel : uint8_t
+{
+    None = ARTNET_LOG_LEVEL_NONE,
+    Error = ARTNET_LOG_LEVEL_ERROR,
+    Warn = ARTNET_LOG_LEVEL_WARN,
+    Info = ARTNET_LOG_LEVEL_INFO,
+    Debug = ARTNET_LOG_LEVEL_DEBUG,
+};
+
+// Print wrapper for the log messages of a level
+// If the level is above ARTNET_LOG_LEVEL, all functions are empty and the calls (and the strings) are removed by the compiler
+template <LogLevel Level, bool Enabled = (static_cast<uint8_t>(Level) <= ARTNET_LOG_LEVEL)>
+struct Log
+{
+    Print *out;
+
+    template <typename T>
+    void print(const T &value) { this->out->print(value); }
+    template <typename T>
+    void print(const T &value, int base) { this->out->print(value, base); }
+    template <typename T>
+    void println(const T &value) { this->out->println(value); }
+    template <typename T>
+    void println(const T &value, int base) { this->out->println(value, base); }
+};
+
+template <LogLevel Level>
+struct Log<Level, false>
+{
+    Print *out;
+
+    template <typename T>
+    void print(const T &) {}
+    template <typename T>
+    void print(const T &, int) {}
+    template <typename T>
+    void println(const T &) {}
+    template <typename T>
+    void println(const T &, int) {}
+};
+
+namespace logging {
+
+inline Log<LogLevel::Error> error(Print *out) { return Log<LogLevel::Error> {out}; }
+inline Log<LogLevel::Warn> warn(Print *out) { return Log<LogLevel::Warn> {out}; }
+inline Log<LogLevel::Info> info(Print *out) { return Log<LogLevel::Info> {out}; }
+inline Log<LogLevel::Debug> debug(Print *out) { return Log<LogLevel::Debug> {out}; }
+
+} // namespace logging
+} // namespace art_net
+
+#endif // ARTNET_LOG_H
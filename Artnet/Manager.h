@@ -9,20 +9,88 @@
 
 namespace art_net {
 
-template <typename S>
-class Manager : public IManager, public Sender_<S>, public Receiver_<S>
+template <PacketBufferMode Mode>
+struct ManagerPacketBuffers;
+
+template <>
+struct ManagerPacketBuffers<PacketBufferMode::Separate>
+{
+    uint8_t sender[PACKET_SIZE];
+    uint8_t receiver[PACKET_SIZE];
+
+    uint8_t *forSender() { return this->sender; }
+    uint8_t *forReceiver() { return this->receiver; }
+    PacketOwner *owner() { return nullptr; }
+};
+
+// Sender and Receiver use the same buffer.
+// Because parse() and send functions are serialized in loop(), the buffer is never used by both at the same time.
+// NOTE: Data set by setArtDmxData() / setArtNzsData() is overwritten by parse(),
+//       so please set the data again after parse() before streamArtDmxTo() / streamArtNzsTo().
+//       Otherwise streamArtDmxTo() / streamArtNzsTo() don't send the received data (counted in SenderStats::stale_data).
+// NOTE: Do not send packets from inside the receiver callbacks because the received data is in the same buffer.
+template <>
+struct ManagerPacketBuffers<PacketBufferMode::Shared>
+{
+    uint8_t shared[PACKET_SIZE];
+    PacketOwner last_writer {PacketOwner::None};
+
+    uint8_t *forSender() { return this->shared; }
+    uint8_t *forReceiver() { return this->shared; }
+    PacketOwner *owner() { return &this->last_writer; }
+};
+
+// All runtime state of Manager in one block: the packet buffer(s), the subscriptions and ArtPollReply timers of Receiver_,
+// and the sequences and streaming timers of Sender_ (no heap allocation, sizeof() is the whole RAM used besides S)
+template <size_t MaxUniverses, size_t MaxDestinations, PacketBufferMode Mode>
+struct ManagerState
+{
+    ManagerPacketBuffers<Mode> buffers;
+    ReceiverState<MaxUniverses> receiver;
+    SenderState<MaxDestinations> sender;
+};
+
+template <
+    typename S,
+    size_t MaxUniverses = DEFAULT_MAX_UNIVERSES,
+    size_t MaxDestinations = DEFAULT_MAX_DESTINATIONS,
+    PacketBufferMode BufferMode = PacketBufferMode::Separate
+>
+class Manager : public IManager, public Sender_<S, MaxDestinations>, public Receiver_<S, MaxUniverses>
 {
     S stream;
+    ManagerState<MaxUniverses, MaxDestinations, BufferMode> state;
 
 public:
+    Manager()
+    {
+        this->Sender_<S, MaxDestinations>::attachPacketBuffer(this->state.buffers.forSender(), this->state.buffers.owner());
+        this->Sender_<S, MaxDestinations>::attachState(this->state.sender);
+        this->Receiver_<S, MaxUniverses>::attachPacketBuffer(this->state.buffers.forReceiver(), this->state.buffers.owner());
+        this->Receiver_<S, MaxUniverses>::attachState(this->state.receiver);
+    }
+
     void begin(uint16_t port = DEFAULT_PORT) override
     {
         this->stream.begin(port);
-        this->Sender_<S>::attach(this->stream);
-        this->Receiver_<S>::attach(this->stream);
+        this->Sender_<S, MaxDestinations>::attach(this->stream);
+        this->Receiver_<S, MaxUniverses>::attach(this->stream);
     }
+
+#if ARTNET_ENABLE_CAPTURE
+    // capture both sent and received datagrams into the same sink
+    void setCaptureSink(ICaptureSink *sink) override
+    {
+        this->Sender_<S, MaxDestinations>::setCaptureSink(sink);
+        this->Receiver_<S, MaxUniverses>::setCaptureSink(sink);
+    }
+#endif
 };
 
+// Manager which shares one packet buffer between Sender and Receiver to save RAM on small targets
+template <typename S, size_t MaxUniverses = DEFAULT_MAX_UNIVERSES, size_t MaxDestinations = DEFAULT_MAX_DESTINATIONS>
+using CompactManager = Manager<S, MaxUniverses, MaxDestinations, PacketBufferMode::Shared>;
+
 } // namespace art_net
 
 #endif // ARTNET_MANAGER_H
@@ -0,0 +1,118 @@
+#pragma once
+#ifndef ARTNET_PACKET_RING_H
+#define ARTNET_PACKET_RING_H
+
+#include "Common.h"
+#include <atomic>
+
+namespace art_net {
+
+// Single-producer / single-consumer ring to pass items between threads
+// - slots are preallocated inline, there is no lock and no heap allocation per item
+// - prepare() / commit() / drop() must be called only from the producer thread, front() / pop() only from the consumer thread
+// - if the ring is full, the item is dropped and counted by drops()
+template <typename T, size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity of SpscRing should be a power of 2");
+
+public:
+    using Slot = T;
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE {64};
+
+    Slot slots[Capacity];
+    // head is written only by the producer, tail only by the consumer (separate cache lines to avoid false sharing)
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head {0};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail {0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> num_drops {0};
+
+public:
+    static constexpr size_t capacity() { return Capacity; }
+
+    /// @brief Next free slot to be filled in place (producer), publish it by commit()
+    /// @return nullptr if the ring is full
+    Slot *prepare()
+    {
+        const size_t h = this->head.load(std::memory_order_relaxed);
+        if (h - this->tail.load(std::memory_order_acquire) >= Capacity) {
+            return nullptr;
+        }
+        return &this->slots[h & (Capacity - 1)];
+    }
+
+    // publish the slot returned by prepare() to the consumer (producer)
+    void commit()
+    {
+        this->head.store(this->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // count the item which was dropped because the ring was full (producer)
+    void drop()
+    {
+        this->num_drops.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// @brief Oldest item in the ring (consumer)
+    /// @return nullptr if the ring is empty
+    const Slot *front() const
+    {
+        const size_t t = this->tail.load(std::memory_order_relaxed);
+        if (t == this->head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &this->slots[t & (Capacity - 1)];
+    }
+
+    // release the slot returned by front() (consumer)
+    void pop()
+    {
+        this->tail.store(this->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // number of items waiting in the ring (approximate if called from other threads)
+    size_t occupancy() const
+    {
+        const size_t t = this->tail.load(std::memory_order_acquire);
+        return this->head.load(std::memory_order_acquire) - t;
+    }
+
+    uint32_t drops() const
+    {
+        return this->num_drops.load(std::memory_order_relaxed);
+    }
+};
+
+struct PacketSlot
+{
+    uint16_t size;
+    RemoteInfo remote;
+    uint8_t data[PACKET_SIZE];
+};
+
+// SpscRing of received packets
+template <size_t Capacity>
+class PacketRing : public SpscRing<PacketSlot, Capacity>
+{
+public:
+    /// @brief Copy the packet into the next slot (producer)
+    /// @return false if the ring is full and the packet was dropped
+    bool push(const uint8_t *data, size_t size, const RemoteInfo &remote)
+    {
+        PacketSlot *slot = this->prepare();
+        if (!slot) {
+            this->drop();
+            return false;
+        }
+        slot->size = static_cast<uint16_t>(size < PACKET_SIZE ? size : PACKET_SIZE);
+        slot->remote = remote;
+        memcpy(slot->data, data, slot->size);
+        this->commit();
+        return true;
+    }
+};
+
+} // namespace art_net
+
+#endif // ARTNET_PACKET_RING_H
@@ -0,0 +1,186 @@
+#pragma once
+#ifndef ARTNET_PIPELINE_RECEIVER_H
+#define ARTNET_PIPELINE_RECEIVER_H
+
+#include "Receiver.h"
+#include "PacketRing.h"
+
+namespace art_net {
+
+// Receiver which splits reading the network and dispatching the callbacks into two threads
+// - receive() on the read thread moves datagrams from the stream into a preallocated SPSC ring
+// - dispatch() on the dispatch thread parses them, applies the source filter and runs the callbacks
+// - there is no lock and no allocation per packet. If the dispatch thread is too slow,
+//   the packets are dropped at the ring (counted by drops()) and the socket is kept drained
+// - ArtPoll is scheduled by dispatch() same as Receiver, and the reply (config and universes) is rendered there
+//   when it is due. Only the sending is passed back to the read thread through another SPSC ring,
+//   because only one thread may use the stream (e.g. remoteIP() and the buffer of ESP32 WiFiUDP).
+//   So the subscriptions and the config are read only by the dispatch thread
+// - the stats and the capture of Receiver are updated only by the dispatch thread.
+//   ArtPollReply sent by the read thread is not counted there (see pollReplySendFailures())
+// RingSize: number of packet slots (power of 2, PACKET_SIZE bytes each)
+// NOTE: callbacks can be subscribed from any thread if ARTNET_THREAD_SAFE_SUBSCRIPTIONS is enabled
+// NOTE: datagrams from filtered sources also take slots of the ring until they are dropped by dispatch()
+// NOTE: set the ArtPollReply config before starting the threads or on the dispatch thread (it is read by dispatch())
+template <typename S, size_t RingSize = 8, size_t MaxUniverses = DEFAULT_MAX_UNIVERSES, typename Routes = art_dmx::RouteList<>>
+class PipelineReceiver : public Receiver<S, MaxUniverses, Routes>
+{
+    PacketRing<RingSize> ring;
+    uint8_t drop_buffer[PACKET_SIZE];
+
+#if ARTNET_ENABLE_ART_POLL_REPLY
+    // ArtPollReply rendered by the dispatch thread, sent by the read thread
+    struct PollReplyJob
+    {
+        IPAddress ip;
+        art_poll_reply::Packet reply;
+        typename Receiver_<S, MaxUniverses, Routes>::PollReplyUniverses universes;
+    };
+    // as many as the replies which can be due at the same time
+    static constexpr size_t POLL_REPLY_RING_SIZE {4};
+    static_assert(POLL_REPLY_RING_SIZE >= PENDING_POLL_REPLY_CACHE_SIZE, "all due ArtPollReply should fit in the ring");
+
+    SpscRing<PollReplyJob, POLL_REPLY_RING_SIZE> poll_reply_ring;
+    std::atomic<uint32_t> poll_reply_send_failures {0};
+#endif
+
+public:
+    PipelineReceiver()
+    {
+#if ARTNET_ENABLE_ART_POLL_REPLY
+        // scheduled and rendered by dispatch(), sent by receive()
+        this->setArtPollReplyEnabled(false);
+#endif
+    }
+
+    /// @brief Move received datagrams into the ring (call on the read thread)
+    /// @param max_packets max number of datagrams to read in this call
+    /// @return number of datagrams read from the stream (including dropped ones)
+    size_t receive(size_t max_packets = RingSize)
+    {
+#if ARTNET_ENABLE_ART_POLL_REPLY
+        this->sendPollReplies();
+#endif
+        size_t n = 0;
+        for (; n < max_packets; ++n) {
+            typename PacketRing<RingSize>::Slot *slot = this->ring.prepare();
+            if (slot) {
+                const size_t size = this->readDatagram(slot->data, PACKET_SIZE, slot->remote);
+                if (size == 0) {
+                    break;
+                }
+                slot->size = static_cast<uint16_t>(size);
+                this->ring.commit();
+            } else {
+                RemoteInfo remote;
+                const size_t size = this->readDatagram(this->drop_buffer, PACKET_SIZE, remote);
+                if (size == 0) {
+                    break;
+                }
+                this->ring.drop();
+            }
+        }
+        return n;
+    }
+
+    /// @brief Parse the datagrams in the ring and run the callbacks (call on the dispatch thread)
+    /// @param max_packets max number of datagrams to dispatch in this call
+    /// @return number of datagrams dispatched
+    /// @note call this periodically even if nothing is received, to prepare the due ArtPollReply
+    size_t dispatch(size_t max_packets = RingSize)
+    {
+        size_t n = 0;
+        for (; n < max_packets; ++n) {
+            const typename PacketRing<RingSize>::Slot *slot = this->ring.front();
+            if (!slot) {
+                break;
+            }
+            const OpCode op_code = this->parse(slot->data, slot->size, slot->remote);
+#if ARTNET_ENABLE_ART_POLL_REPLY
+            if (op_code == OpCode::Poll) {
+                this->scheduleArtPollReply(slot->remote);
+            }
+#else
+            (void)op_code;
+#endif
+            this->ring.pop();
+        }
+#if ARTNET_ENABLE_ART_POLL_REPLY
+        this->forEachDuePollReply([this](const RemoteInfo &remote) {
+            this->preparePollReply(remote);
+        });
+#endif
+        return n;
+    }
+
+    // same as dispatch(0): prepare the due ArtPollReply (call on the dispatch thread)
+    void update()
+    {
+        this->dispatch(0);
+    }
+
+    // number of datagrams waiting to be dispatched
+    size_t occupancy() const
+    {
+        return this->ring.occupancy();
+    }
+
+    // number of datagrams dropped because the ring was full
+    uint32_t drops() const
+    {
+        return this->ring.drops();
+    }
+
+    static constexpr size_t capacity()
+    {
+        return RingSize;
+    }
+
+#if ARTNET_ENABLE_ART_POLL_REPLY
+    // number of ArtPollReply packets which failed to be sent by the read thread
+    // (a whole reply counts 1 if the read thread was too far behind to take it)
+    uint32_t pollReplySendFailures() const
+    {
+        return this->poll_reply_send_failures.load(std::memory_order_relaxed);
+    }
+#endif
+
+private:
+#if ARTNET_ENABLE_ART_POLL_REPLY
+    // on the dispatch thread
+    void preparePollReply(const RemoteInfo &remote)
+    {
+        PollReplyJob *job = this->poll_reply_ring.prepare();
+        if (!job) {
+            this->poll_reply_ring.drop();
+            this->poll_reply_send_failures.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        job->ip = remote.ip;
+        job->reply = this->makeArtPollReply();
+        this->collectArtPollReplyUniverses(job->universes);
+        this->poll_reply_ring.commit();
+    }
+
+    // on the read thread
+    void sendPollReplies()
+    {
+        while (const PollReplyJob *job = this->poll_reply_ring.front()) {
+            art_poll_reply::Packet reply = job->reply;
+            uint32_t num_failures = 0;
+            for (const auto &u_pair : job->universes) {
+                art_poll_reply::setUniverseTo(reply, u_pair.first);
+                num_failures += this->writeArtPollReply(job->ip, reply) ? 0 : 1;
+            }
+            this->poll_reply_ring.pop();
+            if (num_failures > 0) {
+                this->poll_reply_send_failures.fetch_add(num_failures, std::memory_order_relaxed);
+            }
+        }
+    }
+#endif
+};
+
+} // namespace art_net
+
+#endif // ARTNET_PIPELINE_RECEIVER_H
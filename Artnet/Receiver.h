@@ -8,6 +8,14 @@
 #include "ArtPollReply.h"
 #include "ArtTrigger.h"
 #include "ArtSync.h"
+#include "ArtTimeCode.h"
+#include "SnapshotTable.h"
+#include "Stats.h"
+#include "Log.h"
+#include "Trace.h"
+#include "Clock.h"
+#include "Capture.h"
+#include "FastLEDMap.h"
 #include "ReceiverTraits.h"
 
 namespace art_net {
@@ -22,157 +30,265 @@ static NoPrint no_log;
 
 } // namespace
 
-template <typename S>
+#if ARTNET_ENABLE_FASTLED && ARTNET_ENABLE_ART_SYNC
+// strip notified of ArtSync (the range is kept to find it without touching the strip)
+struct FastLEDMapEntry
+{
+    FastLEDMap *map;
+    uint16_t num_universes;
+};
+#endif
+
+// Callbacks subscribed to Receiver_ (published as a whole by SnapshotTable)
+template <size_t MaxUniverses>
+struct Subscriptions
+{
+#if ARTNET_ENABLE_ART_DMX
+    FlatMap<uint16_t, SnapshotCallback<art_dmx::CallbackType>, MaxUniverses> art_dmx_universes;
+    SnapshotCallback<art_dmx::CallbackType> art_dmx;
+#endif
+#if ARTNET_ENABLE_ART_NZS
+    FlatMap<uint16_t, SnapshotCallback<art_nzs::CallbackType>, MaxUniverses> art_nzs_universes;
+#endif
+#if ARTNET_ENABLE_ART_SYNC
+    SnapshotCallback<art_sync::CallbackType> art_sync;
+#endif
+#if ARTNET_ENABLE_ART_TRIGGER
+    SnapshotCallback<art_trigger::CallbackType> art_trigger;
+#endif
+#if ARTNET_ENABLE_ART_TIMECODE
+    SnapshotCallback<art_timecode::CallbackType> art_timecode;
+#endif
+#if ARTNET_ENABLE_FASTLED && ARTNET_ENABLE_ART_SYNC
+    // strips notified of ArtSync (by start universe)
+    FlatMap<uint16_t, FastLEDMapEntry, MAX_FASTLED_MAPS> fastled_maps;
+#endif
+};
+
+#if ARTNET_ENABLE_ART_POLL_REPLY
+static constexpr uint16_t PENDING_POLL_REPLY_CACHE_SIZE {3};
+static constexpr uint16_t MAX_POLL_REPLY_DELAY_MS {1000};
+
+// ArtPoll waiting for the random delay before ArtPollReply is sent
+struct PendingPollReply
+{
+    // NOTE: To simplify the logic, we use fixed size array and do not remove old entries
+    bool active {false};
+    RemoteInfo remote {};
+    uint32_t requested_at_ms {0};
+    uint32_t wait_ms {0};
+};
+#endif
+
+// Runtime tables of Receiver_ (subscriptions and ArtPollReply timers)
+// Receiver keeps it inline, and Manager keeps it in one block with the tables of Sender_ (see ManagerState)
+template <size_t MaxUniverses>
+struct ReceiverState
+{
+    // subscriptions can be updated from other threads while parse() is running (see ARTNET_THREAD_SAFE_SUBSCRIPTIONS)
+    SnapshotTable<Subscriptions<MaxUniverses>> subscriptions;
+#if ARTNET_ENABLE_ART_POLL_REPLY
+    Array<PENDING_POLL_REPLY_CACHE_SIZE, PendingPollReply> pending_poll_replies {};
+#endif
+};
+
+// MaxUniverses: capacity of runtime subscriptions for each of ArtDmx and ArtNzs (no heap allocation)
+// Routes: compile-time ArtDmx universe routes (e.g. ArtDmxRoutes<ArtDmxRoute<1, Handler1>, ArtDmxRoute<2, Handler2>>)
+template <typename S, size_t MaxUniverses = DEFAULT_MAX_UNIVERSES, typename Routes = art_dmx::RouteList<>>
 #ifndef ARDUINO_ARCH_AVR
 class Receiver_ : virtual IReceiver_
 #else
 class Receiver_
 #endif
 {
-    S *stream;
-    Array<PACKET_SIZE> packet;
-
-    art_dmx::CallbackMap callback_art_dmx_universes;
-    art_dmx::CallbackType callback_art_dmx;
-    art_nzs::CallbackMap callback_art_nzs_universes;
-    art_sync::CallbackType callback_art_sync;
-    art_trigger::CallbackType callback_art_trigger;
-    ArtPollReplyConfig art_poll_reply_config;
+    S *stream {nullptr};
+    PacketRef packet;
+    ReceiverState<MaxUniverses> *tables {nullptr};
 
     Print *logger {&no_log};
 
-    static constexpr uint16_t PENDING_POLL_REPLY_CACHE_SIZE {3};
-    static constexpr uint16_t MAX_POLL_REPLY_DELAY_MS {1000};
+#if ARTNET_ENABLE_CAPTURE
+    ICaptureSink *capture_sink {nullptr};
+#endif
 
-    struct PendingPollReply
-    {
-        // NOTE: To simplify the logic, we use fixed size array and do not remove old entries
-        bool active {false};
-        RemoteInfo remote {};
-        uint32_t requested_at_ms {0};
-        uint32_t wait_ms {0};
-    };
+#if ARTNET_ENABLE_SOURCE_FILTER
+    SourceFilter<DEFAULT_MAX_SOURCE_FILTERS> source_filter;
+#endif
 
-    Array<PENDING_POLL_REPLY_CACHE_SIZE, PendingPollReply> pending_poll_replies {};
+#if ARTNET_ENABLE_STATS
+    ReceiverStats<MaxUniverses> receive_stats;
+#endif
 
-public:
-#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
-#else
-    Receiver_()
-    {
-        this->packet.resize(PACKET_SIZE);
-    }
+#if ARTNET_ENABLE_ART_POLL_REPLY
+    ArtPollReplyConfig art_poll_reply_config;
+    bool art_poll_reply_enabled {true};
 #endif
 
+public:
     OpCode parse()
     {
         if (!isNetworkReady<S>()) {
             return OpCode::NoPacket;
         }
 
+#if ARTNET_ENABLE_ART_POLL_REPLY
         this->processPendingPollReplies();
+#endif
 
+        trace::Scope trace_parse_packet(trace::Event::ParsePacket);
         size_t size = this->stream->parsePacket();
         if (size == 0) {
+            trace_parse_packet.cancel();
             return OpCode::NoPacket;
         }
+        trace_parse_packet.end();
+        const uint32_t received_us = Clock<S>::micros();
 
-        this->logger->print(F("Packet received: size = "));
-        this->logger->println(size);
+        logging::debug(this->logger).print(F("Packet received: size = "));
+        logging::debug(this->logger).println(size);
+
+        RemoteInfo remote_info;
+        remote_info.ip = this->stream->S::remoteIP();
+        remote_info.port = (uint16_t)this->stream->S::remotePort();
+        remote_info.received_us = received_us;
+
+        // discard without reading the payload
+        if (!this->acceptSource(remote_info.ip)) {
+            this->stream->flush();
+            return OpCode::Filtered;
+        }
 
         if (size > PACKET_SIZE) {
-            this->logger->print(F("Packet size is unexpectedly too large: "));
-            this->logger->println(size);
+            logging::warn(this->logger).print(F("Packet size is unexpectedly too large: "));
+            logging::warn(this->logger).println(size);
+            this->countDrop(&ReceiveDrops::oversize);
             size = PACKET_SIZE;
         }
+        trace::Scope trace_read(trace::Event::Read);
+        this->packet.claim(PacketOwner::Receiver);
         this->stream->read(this->packet.data(), size);
+        trace_read.end();
 
-        if (!checkID()) {
-            this->logger->println(F("Packet ID is not Art-Net"));
-            return OpCode::ParseFailed;
-        }
+        this->captureDatagram(CaptureDirection::Received, remote_info.ip, remote_info.port, received_us, this->packet.data(), size);
+        OpCode op_code = this->dispatch(size, remote_info);
+        this->stream->flush();
+        return op_code;
+    }
 
-        RemoteInfo remote_info;
-        remote_info.ip = this->stream->S::remoteIP();
-        remote_info.port = (uint16_t)this->stream->S::remotePort();
+    // parse the datagram which is already received (e.g. by other threads, or from recorded data)
+    // NOTE: ArtPollReply is sent to the stream attached by begin()
+    OpCode parse(const uint8_t *data, size_t size, const RemoteInfo &remote)
+    {
+        if (size == 0) {
+            return OpCode::NoPacket;
+        }
+        if (!this->acceptSource(remote.ip)) {
+            return OpCode::Filtered;
+        }
+        if (size > PACKET_SIZE) {
+            logging::warn(this->logger).print(F("Packet size is unexpectedly too large: "));
+            logging::warn(this->logger).println(size);
+            this->countDrop(&ReceiveDrops::oversize);
+            size = PACKET_SIZE;
+        }
+        this->packet.claim(PacketOwner::Receiver);
+        memcpy(this->packet.data(), data, size);
+        if (remote.received_us == 0) {
+            // not stamped by the reader
+            RemoteInfo stamped = remote;
+            stamped.received_us = Clock<S>::micros();
+            this->captureDatagram(CaptureDirection::Received, stamped.ip, stamped.port, stamped.received_us, this->packet.data(), size);
+            return this->dispatch(size, stamped);
+        }
+        this->captureDatagram(CaptureDirection::Received, remote.ip, remote.port, remote.received_us, this->packet.data(), size);
+        return this->dispatch(size, remote);
+    }
 
-        OpCode op_code = OpCode::Unsupported;
-        OpCode received_op_code = static_cast<OpCode>(this->getOpCode());
-        switch (received_op_code) {
-            case OpCode::Dmx: {
-                art_dmx::Metadata metadata = art_dmx::generateMetadataFrom(this->packet.data());
-                if (this->callback_art_dmx) {
-                    this->callback_art_dmx(this->getArtDmxData(), size - HEADER_SIZE, metadata, remote_info);
-                }
-                for (auto& cb : this->callback_art_dmx_universes) {
-                    if (this->getArtDmxUniverse15bit() == cb.first) {
-                        cb.second(this->getArtDmxData(), size - HEADER_SIZE, metadata, remote_info);
-                    }
-                }
-                op_code = OpCode::Dmx;
-                break;
-            }
-            case OpCode::Nzs: {
-                art_nzs::Metadata metadata = art_nzs::generateMetadataFrom(this->packet.data());
-                for (auto& cb : this->callback_art_nzs_universes) {
-                    if (this->getArtDmxUniverse15bit() == cb.first) {
-                        cb.second(this->getArtDmxData(), size - HEADER_SIZE, metadata, remote_info);
-                    }
-                }
-                op_code = OpCode::Nzs;
-                break;
+    /// @brief Read one datagram from the stream without dispatching (to dispatch it later by parse(data, size, remote))
+    /// @return size of the datagram (truncated to `size`), or 0 if there is no datagram
+    /// @note datagrams dropped by the source filter are skipped
+    size_t receiveRaw(uint8_t *data, size_t size, RemoteInfo &remote)
+    {
+        if (!isNetworkReady<S>()) {
+            return 0;
+        }
+        while (true) {
+            size_t received = this->stream->parsePacket();
+            if (received == 0) {
+                return 0;
             }
-            case OpCode::Poll: {
-                this->scheduleArtPollReply(remote_info);
-                op_code = OpCode::Poll;
-                break;
+            remote.ip = this->stream->S::remoteIP();
+            remote.port = (uint16_t)this->stream->S::remotePort();
+            remote.received_us = Clock<S>::micros();
+            if (!this->acceptSource(remote.ip)) {
+                this->stream->flush();
+                continue;
             }
-            case OpCode::Trigger: {
-                if (this->callback_art_trigger) {
-                    ArtTriggerMetadata metadata = {
-                        .oem = this->getArtTriggerOEM(),
-                        .key = this->getArtTriggerKey(),
-                        .sub_key = this->getArtTriggerSubKey(),
-                        .payload = this->getArtTriggerPayload(),
-                        .size = static_cast<uint16_t>(size - art_trigger::PAYLOAD),
-                    };
-                    this->callback_art_trigger(metadata, remote_info);
-                }
-                op_code = OpCode::Trigger;
-                break;
+            if (received > size) {
+                received = size;
             }
-            case OpCode::Sync: {
-                if (this->callback_art_sync) {
-                    this->callback_art_sync(remote_info);
-                }
-                op_code = OpCode::Sync;
-                break;
+            this->stream->read(data, received);
+            this->stream->flush();
+            return received;
+        }
+    }
+
+    // send scheduled ArtPollReply if the delay has elapsed
+    // parse() does this, so call this periodically only if packets are passed to parse(data, size, remote)
+    void update()
+    {
+#if ARTNET_ENABLE_ART_POLL_REPLY
+        this->processPendingPollReplies();
+#endif
+    }
+
+    /// @brief Time until the next scheduled ArtPollReply should be sent (to decide the timeout of event loops)
+    /// @return milliseconds (0 if already due), or UINT32_MAX if nothing is scheduled
+    uint32_t nextPollReplyDelayMs() const
+    {
+        uint32_t delay_ms = UINT32_MAX;
+#if ARTNET_ENABLE_ART_POLL_REPLY
+        const uint32_t now = Clock<S>::millis();
+        for (const auto &pending : this->tables->pending_poll_replies) {
+            if (!pending.active) {
+                continue;
             }
-            default: {
-                this->logger->print(F("Unsupported OpCode: "));
-                this->logger->println(this->getOpCode(), HEX);
-                op_code = OpCode::Unsupported;
-                break;
+            const uint32_t elapsed = now - pending.requested_at_ms;
+            const uint32_t remaining = elapsed >= pending.wait_ms ? 0 : pending.wait_ms - elapsed;
+            if (remaining < delay_ms) {
+                delay_ms = remaining;
             }
         }
+#endif
+        return delay_ms;
+    }
 
-        this->stream->flush();
-        return op_code;
+    // file descriptor of the receive socket to wait for datagrams in event loops (-1 if not available)
+    int fd() const
+    {
+        return this->stream ? FileDescriptor<S>::get(*this->stream) : -1;
     }
 
+    // parse() and receiveRaw() read nothing until the network is ready (event loops should back off meanwhile)
+    bool isStreamReady() const
+    {
+        return this->stream && isNetworkReady<S>();
+    }
+
+#if ARTNET_ENABLE_ART_DMX
     // subscribe artdmx packet for specified net, subnet, and universe
     void subscribeArtDmxUniverse(uint8_t net, uint8_t subnet, uint8_t universe, const ArtDmxCallback& func)
     {
         if (net > 0x7F) {
-            this->logger->println(F("net should be less than 0x7F"));
+            logging::error(this->logger).println(F("net should be less than 0x7F"));
             return;
         }
         if (subnet > 0xF) {
-            this->logger->println(F("subnet should be less than 0xF"));
+            logging::error(this->logger).println(F("subnet should be less than 0xF"));
             return;
         }
         if (universe > 0xF) {
-            this->logger->println(F("universe should be less than 0xF"));
+            logging::error(this->logger).println(F("universe should be less than 0xF"));
             return;
         }
         uint16_t u = ((uint16_t)net << 8) | ((uint16_t)subnet << 4) | (uint16_t)universe;
@@ -182,31 +298,20 @@ public:
     // subscribe artdmx packet for specified universe (15 bit)
     void subscribeArtDmxUniverse(uint16_t universe, const ArtDmxCallback& func)
     {
-        this->callback_art_dmx_universes.insert(std::make_pair(universe, func));
-    }
-
-    // subscribe artnzs packet for specified universe (15 bit)
-    void subscribeArtNzsUniverse(uint16_t universe, const ArtNzsCallback& func)
-    {
-        this->callback_art_nzs_universes.insert(std::make_pair(universe, func));
+        const bool inserted = this->tables->subscriptions.update([&](Subscriptions<MaxUniverses> &subs) {
+            return subs.art_dmx_universes.insert(universe, func) != nullptr;
+        });
+        if (!inserted) {
+            logging::error(this->logger).println(F("too many ArtDmx universes are subscribed (increase MaxUniverses)"));
+        }
     }
 
     // subscribe artdmx packet for all universes
     void subscribeArtDmx(const ArtDmxCallback& func)
     {
-        this->callback_art_dmx = func;
-    }
-
-    // subscribe other packets
-    void subscribeArtSync(const ArtSyncCallback& func)
-    {
-        this->callback_art_sync = func;
-    }
-
-    // subscribe art_trigger packet
-    void subscribeArtTrigger(const ArtTriggerCallback& func)
-    {
-        this->callback_art_trigger = func;
+        this->tables->subscriptions.update([&](Subscriptions<MaxUniverses> &subs) {
+            subs.art_dmx = func;
+        });
     }
 
     void unsubscribeArtDmxUniverse(uint8_t net, uint8_t subnet, uint8_t universe)
@@ -216,39 +321,110 @@ public:
     }
     void unsubscribeArtDmxUniverse(uint16_t universe)
     {
-        auto it = this->callback_art_dmx_universes.find(universe);
-        if (it != this->callback_art_dmx_universes.end()) {
-            this->callback_art_dmx_universes.erase(it);
-        }
+        this->tables->subscriptions.update([&](Subscriptions<MaxUniverses> &subs) {
+            subs.art_dmx_universes.erase(universe);
+#if ARTNET_ENABLE_FASTLED && ARTNET_ENABLE_ART_SYNC
+            // the strip may be destroyed after its universe is unsubscribed
+            eraseFastLEDMapOf(subs, universe);
+#endif
+        });
+        this->tables->subscriptions.synchronize();
     }
     void unsubscribeArtDmxUniverses()
     {
-        this->callback_art_dmx_universes.clear();
+        this->tables->subscriptions.update([](Subscriptions<MaxUniverses> &subs) {
+            subs.art_dmx_universes.clear();
+#if ARTNET_ENABLE_FASTLED && ARTNET_ENABLE_ART_SYNC
+            subs.fastled_maps.clear();
+#endif
+        });
+        this->tables->subscriptions.synchronize();
     }
     void unsubscribeArtDmx()
     {
-        this->callback_art_dmx = nullptr;
+        this->tables->subscriptions.update([](Subscriptions<MaxUniverses> &subs) {
+            subs.art_dmx = nullptr;
+        });
+        this->tables->subscriptions.synchronize();
     }
+#endif
 
-    void unsubscribeArtNzsUniverse(uint16_t universe)
+#if ARTNET_ENABLE_ART_NZS
+    // subscribe artnzs packet for specified universe (15 bit)
+    void subscribeArtNzsUniverse(uint16_t universe, const ArtNzsCallback& func)
     {
-        auto it = this->callback_art_nzs_universes.find(universe);
-        if (it != this->callback_art_nzs_universes.end()) {
-            this->callback_art_nzs_universes.erase(it);
+        const bool inserted = this->tables->subscriptions.update([&](Subscriptions<MaxUniverses> &subs) {
+            return subs.art_nzs_universes.insert(universe, func) != nullptr;
+        });
+        if (!inserted) {
+            logging::error(this->logger).println(F("too many ArtNzs universes are subscribed (increase MaxUniverses)"));
         }
     }
 
+    void unsubscribeArtNzsUniverse(uint16_t universe)
+    {
+        this->tables->subscriptions.update([&](Subscriptions<MaxUniverses> &subs) {
+            subs.art_nzs_universes.erase(universe);
+        });
+        this->tables->subscriptions.synchronize();
+    }
+#endif
+
+#if ARTNET_ENABLE_ART_SYNC
+    // subscribe other packets
+    void subscribeArtSync(const ArtSyncCallback& func)
+    {
+        this->tables->subscriptions.update([&](Subscriptions<MaxUniverses> &subs) {
+            subs.art_sync = func;
+        });
+    }
+
     void unsubscribeArtSync()
     {
-        this->callback_art_sync = nullptr;
+        this->tables->subscriptions.update([](Subscriptions<MaxUniverses> &subs) {
+            subs.art_sync = nullptr;
+        });
+        this->tables->subscriptions.synchronize();
+    }
+#endif
+
+#if ARTNET_ENABLE_ART_TRIGGER
+    // subscribe art_trigger packet
+    void subscribeArtTrigger(const ArtTriggerCallback& func)
+    {
+        this->tables->subscriptions.update([&](Subscriptions<MaxUniverses> &subs) {
+            subs.art_trigger = func;
+        });
     }
 
     void unsubscribeArtTrigger()
     {
-        this->callback_art_trigger = nullptr;
+        this->tables->subscriptions.update([](Subscriptions<MaxUniverses> &subs) {
+            subs.art_trigger = nullptr;
+        });
+        this->tables->subscriptions.synchronize();
     }
+#endif
 
-#ifdef FASTLED_VERSION
+#if ARTNET_ENABLE_ART_TIMECODE
+    // subscribe art_timecode packet (see TimeCodeClock to schedule rendering against the timecode)
+    void subscribeArtTimeCode(const ArtTimeCodeCallback& func)
+    {
+        this->tables->subscriptions.update([&](Subscriptions<MaxUniverses> &subs) {
+            subs.art_timecode = func;
+        });
+    }
+
+    void unsubscribeArtTimeCode()
+    {
+        this->tables->subscriptions.update([](Subscriptions<MaxUniverses> &subs) {
+            subs.art_timecode = nullptr;
+        });
+        this->tables->subscriptions.synchronize();
+    }
+#endif
+
+#if ARTNET_ENABLE_FASTLED
     void forwardArtDmxDataToFastLED(uint8_t net, uint8_t subnet, uint8_t universe, CRGB* leds, uint16_t num)
     {
         uint16_t u = ((uint16_t)net << 8) | ((uint16_t)subnet << 4) | (uint16_t)universe;
@@ -257,28 +433,72 @@ public:
     void forwardArtDmxDataToFastLED(uint16_t universe, CRGB* leds, uint16_t num)
     {
         this->subscribeArtDmxUniverse(universe, [this, leds, num](const uint8_t* data, const uint16_t size, const ArtDmxMetadata &, const RemoteInfo &) {
-            size_t n;
-            if (num <= size / 3) {
-                // OK: requested number of LEDs is less than received data size
-                n = num;
-            } else {
+            size_t n = num;
+            if (n > size / 3) {
+                // fill only the pixels in the packet
+                logging::debug(this->logger).println(F("ArtNet packet size is less than requested LED numbers to forward"));
                 n = size / 3;
-                this->logger->println(F("WARN: ArtNet packet size is less than requested LED numbers to forward"));
-                this->logger->print(F("      requested: "));
-                this->logger->print(num * 3);
-                this->logger->print(F("      received : "));
-                this->logger->println(size);
             }
-            for (size_t pixel = 0; pixel < n; ++pixel) {
-                size_t idx = pixel * 3;
-                leds[pixel].r = data[idx + 0];
-                leds[pixel].g = data[idx + 1];
-                leds[pixel].b = data[idx + 2];
+            memcpy(reinterpret_cast<uint8_t *>(leds), data, 3 * n);
+        });
+    }
+    // forward the universes of the strip (see FastLEDMap), which gets ready when all of them (or ArtSync) are received
+    void forwardArtDmxDataToFastLED(FastLEDMap &map)
+    {
+        if (!map.isValid()) {
+            logging::error(this->logger).println(F("invalid FastLEDMap (pixels per universe, or too many universes)"));
+            return;
+        }
+        FastLEDMap *m = &map;
+        const uint16_t start = map.startUniverse();
+        const uint16_t num = map.numUniverses();
+        // check the capacity first so that nothing is subscribed on failure
+        const bool inserted = this->tables->subscriptions.update([&](Subscriptions<MaxUniverses> &subs) {
+            size_t num_new_universes = 0;
+            for (uint16_t i = 0; i < num; ++i) {
+                if (!subs.art_dmx_universes.find(static_cast<uint16_t>(start + i))) {
+                    ++num_new_universes;
+                }
             }
+            if (subs.art_dmx_universes.size() + num_new_universes > subs.art_dmx_universes.capacity()) {
+                return false;
+            }
+#if ARTNET_ENABLE_ART_SYNC
+            if (!subs.fastled_maps.find(start) && subs.fastled_maps.full()) {
+                return false;
+            }
+            subs.fastled_maps.insert(start, FastLEDMapEntry {m, num});
+#endif
+            for (uint16_t i = 0; i < num; ++i) {
+                subs.art_dmx_universes.insert(static_cast<uint16_t>(start + i), art_dmx::CallbackType([m, i](const uint8_t* data, const uint16_t size, const ArtDmxMetadata &, const RemoteInfo &remote) {
+                    m->setArtDmxData(i, data, size, remote.received_us);
+                }));
+            }
+            return true;
         });
+        if (!inserted) {
+            logging::error(this->logger).println(F("too many universes or FastLEDMap are forwarded (MaxUniverses, MAX_FASTLED_MAPS)"));
+        }
+    }
+    // stop forwarding to the strip and unsubscribe all of its universes (call before destroying the strip)
+    // NOTE: waits until the dispatch thread stops using the strip, except in the callbacks on the dispatch thread
+    void unforwardArtDmxDataToFastLED(FastLEDMap &map)
+    {
+        const uint16_t start = map.startUniverse();
+        const uint16_t num = map.numUniverses();
+        this->tables->subscriptions.update([&](Subscriptions<MaxUniverses> &subs) {
+            for (uint16_t i = 0; i < num; ++i) {
+                subs.art_dmx_universes.erase(static_cast<uint16_t>(start + i));
+            }
+#if ARTNET_ENABLE_ART_SYNC
+            eraseFastLEDMapOf(subs, start);
+#endif
+        });
+        this->tables->subscriptions.synchronize();
     }
 #endif
 
+#if ARTNET_ENABLE_ART_POLL_REPLY
     // https://art-net.org.uk/how-it-works/discovery-packets/artpollreply/
     void setArtPollReplyConfigOem(uint16_t oem)
     {
@@ -350,98 +570,488 @@ public:
     {
         this->art_poll_reply_config = cfg;
     }
+#endif
+
+#if ARTNET_ENABLE_STATS
+    // counters updated by parse() (cheap to read every frame on the same thread)
+    const ReceiverStats<MaxUniverses> &receiverStats() const
+    {
+        return this->receive_stats;
+    }
+    void resetReceiverStats()
+    {
+        this->receive_stats = ReceiverStats<MaxUniverses>();
+    }
+#endif
+
+#if ARTNET_ENABLE_SOURCE_FILTER
+    // accept packets only from the allowed sources (if any source is allowed)
+    // returns false if the filter list is full
+    bool allowSource(const IPAddress &ip)
+    {
+        if (!this->source_filter.allow(ip)) {
+            logging::error(this->logger).println(F("too many source filters (increase ARTNET_DEFAULT_MAX_SOURCE_FILTERS)"));
+            return false;
+        }
+        return true;
+    }
+    // drop packets from the denied sources
+    // returns false if the filter list is full
+    bool denySource(const IPAddress &ip)
+    {
+        if (!this->source_filter.deny(ip)) {
+            logging::error(this->logger).println(F("too many source filters (increase ARTNET_DEFAULT_MAX_SOURCE_FILTERS)"));
+            return false;
+        }
+        return true;
+    }
+    void removeSourceFilter(const IPAddress &ip)
+    {
+        this->source_filter.remove(ip);
+    }
+    void clearSourceFilters()
+    {
+        this->source_filter.clear();
+    }
+    // number of packets dropped by the source filter for each reason
+    SourceFilterDrops sourceFilterDrops() const
+    {
+        return this->source_filter.drops();
+    }
+#endif
 
     void setLogger(Print* logger)
     {
         this->logger = logger;
     }
 
+#if ARTNET_ENABLE_CAPTURE
+    // copy the accepted datagrams and sent ArtPollReply to the sink (e.g. CaptureRing), nullptr to stop
+    void setCaptureSink(ICaptureSink *sink)
+    {
+        this->capture_sink = sink;
+    }
+#endif
+
 protected:
     void attach(S& s)
     {
         this->stream = &s;
     }
 
-private:
-
-    bool checkID() const
+    void attachPacketBuffer(uint8_t *buffer, PacketOwner *owner = nullptr)
     {
-        const char* idptr = reinterpret_cast<const char*>(this->packet.data());
-        return !strcmp(ARTNET_ID, idptr);
+        this->packet.attach(buffer, owner);
     }
 
-    uint16_t getOpCode() const
+    // tables owned by the derived class (attach before subscribing)
+    void attachState(ReceiverState<MaxUniverses> &s)
     {
-        return (this->packet[art_dmx::OP_CODE_H] << 8) | this->packet[art_dmx::OP_CODE_L];
+        this->tables = &s;
     }
 
-    uint16_t getArtDmxUniverse15bit() const
+#if ARTNET_ENABLE_ART_POLL_REPLY
+    // false if the owner replies to ArtPoll by itself: parse() doesn't schedule and update() doesn't send
+    // (parse() still returns OpCode::Poll, and the owner may use scheduleArtPollReply() / forEachDuePollReply(send))
+    void setArtPollReplyEnabled(bool enabled)
     {
-        return (this->packet[art_dmx::NET] << 8) | this->packet[art_dmx::SUBUNI];
+        this->art_poll_reply_enabled = enabled;
     }
 
-    const uint8_t *getArtDmxData() const
-    {
-        return &(this->packet[art_dmx::DATA]);
-    }
+    // sorted and deduplicated on the stack, no heap allocation
+    using PollReplyUniverses = FlatMap<uint16_t, bool, 2 * MaxUniverses + Routes::size() + 1>;
 
-    void sendArtPollReply(const RemoteInfo &remote)
+    // universes listed in ArtPollReply (universe 0 if none is subscribed)
+    // NOTE: reads the subscriptions, so call this only on the thread which calls parse()
+    void collectArtPollReplyUniverses(PollReplyUniverses &universes)
     {
-        const IPAddress my_ip = getLocalIP<S>();
-        uint8_t my_mac[6];
-        getMacAddress<S>(my_mac);
-
-        arx::stdx::map<uint16_t, bool> universes;
-        for (const auto &cb_pair : this->callback_art_dmx_universes) {
-            universes[cb_pair.first] = true;
+        universes.clear();
+        SnapshotReader<Subscriptions<MaxUniverses>> subs(this->tables->subscriptions);
+#if ARTNET_ENABLE_ART_DMX
+        for (const auto &cb_pair : subs->art_dmx_universes) {
+            universes.insert(cb_pair.first, true);
         }
-        for (const auto &cb_pair : this->callback_art_nzs_universes) {
-            universes[cb_pair.first] = true;
+        Routes::collectUniverses(universes);
+#endif
+#if ARTNET_ENABLE_ART_NZS
+        for (const auto &cb_pair : subs->art_nzs_universes) {
+            universes.insert(cb_pair.first, true);
         }
-        // if no universe is subscribed, send reply for universe 0
+#endif
         if (universes.empty()) {
-            universes[0] = true;
+            universes.insert(0, true);
         }
+    }
 
-        for (const auto &u_pair : universes) {
-            art_poll_reply::Packet reply = art_poll_reply::generatePacketFrom(my_ip, my_mac, u_pair.first, this->art_poll_reply_config);
-            this->stream->beginPacket(remote.ip, DEFAULT_PORT);
-            this->stream->write(reply.b, sizeof(art_poll_reply::Packet));
-            this->stream->endPacket();
-        }
+    // ArtPollReply from the config, the universe of each packet is set by art_poll_reply::setUniverseTo()
+    art_poll_reply::Packet makeArtPollReply() const
+    {
+        const IPAddress my_ip = getLocalIP<S>();
+        uint8_t my_mac[6];
+        getMacAddress<S>(my_mac);
+        return art_poll_reply::generatePacketFrom(my_ip, my_mac, 0, this->art_poll_reply_config);
     }
 
-    void processPendingPollReplies()
+    // send one ArtPollReply without the stats and the capture (return true if sent)
+    bool writeArtPollReply(const IPAddress &ip, const art_poll_reply::Packet &reply)
     {
-        const uint32_t now = millis();
-        for (auto &pending : this->pending_poll_replies) {
-            if (!pending.active) {
-                continue;
-            }
-            if (now >= pending.requested_at_ms + pending.wait_ms) {
-                this->sendArtPollReply(pending.remote);
-                pending.active = false;
-            }
+        if (!this->stream) {
+            return false;
         }
+        this->stream->beginPacket(ip, DEFAULT_PORT);
+        this->stream->write(reply.b, sizeof(art_poll_reply::Packet));
+        return this->stream->endPacket() != 0;
     }
+#endif
 
+#if ARTNET_ENABLE_ART_POLL_REPLY
     /// @brief Schedule to send ArtPollReply after random delay up to MAX_POLL_REPLY_DELAY_MS
+    /// (parse() does this for ArtPoll unless setArtPollReplyEnabled(false))
     /// @param remote RemoteInfo of the requester
     /// @note If there are more than PENDING_POLL_REPLY_CACHE_SIZE requests at the same time, the extra requests will be ignored.
     void scheduleArtPollReply(const RemoteInfo &remote)
     {
-        const uint32_t now = millis();
-        for (auto &pending : this->pending_poll_replies) {
+        const uint32_t now = Clock<S>::millis();
+        for (auto &pending : this->tables->pending_poll_replies) {
             if (!pending.active) {
                 pending.active = true;
                 pending.remote = remote;
                 pending.requested_at_ms = now;
-                pending.wait_ms = static_cast<uint32_t>(random(MAX_POLL_REPLY_DELAY_MS + 1));
+                pending.wait_ms = static_cast<uint32_t>(Clock<S>::random(MAX_POLL_REPLY_DELAY_MS + 1));
                 return;
             }
         }
     }
 
+    // call send(remote) for each scheduled ArtPollReply whose delay has elapsed (to send them by the owner)
+    template <typename F>
+    void forEachDuePollReply(F &&send)
+    {
+        const uint32_t now = Clock<S>::millis();
+        for (auto &pending : this->tables->pending_poll_replies) {
+            if (pending.active && isDue(now, pending.requested_at_ms, pending.wait_ms)) {
+                pending.active = false;
+                send(pending.remote);
+            }
+        }
+    }
+#endif
+
+    /// @brief Read one datagram from the stream without the source filter and the stats
+    /// (to read on a thread other than the one which calls parse(data, size, remote))
+    /// @return size of the datagram (truncated to `size`), or 0 if there is no datagram
+    size_t readDatagram(uint8_t *data, size_t size, RemoteInfo &remote)
+    {
+        if (!isNetworkReady<S>()) {
+            return 0;
+        }
+        size_t received = this->stream->parsePacket();
+        if (received == 0) {
+            return 0;
+        }
+        remote.ip = this->stream->S::remoteIP();
+        remote.port = (uint16_t)this->stream->S::remotePort();
+        remote.received_us = Clock<S>::micros();
+        if (received > size) {
+            received = size;
+        }
+        this->stream->read(data, received);
+        this->stream->flush();
+        return received;
+    }
+
+private:
+#if ARTNET_ENABLE_FASTLED && ARTNET_ENABLE_ART_SYNC
+    // remove the strip which has the universe from the ArtSync targets
+    static void eraseFastLEDMapOf(Subscriptions<MaxUniverses> &subs, uint16_t universe)
+    {
+        for (const auto &m : subs.fastled_maps) {
+            if (universe >= m.first && universe - m.first < m.second.num_universes) {
+                const uint16_t start = m.first;
+                subs.fastled_maps.erase(start);
+                return;
+            }
+        }
+    }
+#endif
+
+    bool acceptSource(const IPAddress &ip)
+    {
+#if ARTNET_ENABLE_SOURCE_FILTER
+        if (this->source_filter.check(ip) != SourceFilterResult::Accepted) {
+            this->countDrop(&ReceiveDrops::filtered);
+            return false;
+        }
+        return true;
+#else
+        (void)ip;
+        return true;
+#endif
+    }
+
+    OpCode dispatch(size_t size, const RemoteInfo &remote_info)
+    {
+        trace::Scope trace_dispatch(trace::Event::Dispatch);
+        if (!checkID()) {
+            logging::debug(this->logger).println(F("Packet ID is not Art-Net"));
+            this->countDrop(&ReceiveDrops::bad_id);
+            return OpCode::ParseFailed;
+        }
+
+        SnapshotReader<Subscriptions<MaxUniverses>> subs(this->tables->subscriptions);
+
+        OpCode op_code = OpCode::Unsupported;
+        OpCode received_op_code = static_cast<OpCode>(this->getOpCode());
+        this->countReceived(received_op_code, size);
+        switch (received_op_code) {
+#if ARTNET_ENABLE_ART_DMX
+            case OpCode::Dmx: {
+                art_dmx::Metadata metadata = art_dmx::generateMetadataFrom(this->packet.data());
+                const uint16_t universe = this->getArtDmxUniverse15bit();
+                trace_dispatch.setUniverse(universe);
+                bool delivered = false;
+                if (subs->art_dmx) {
+                    trace::Scope trace_callback(trace::Event::Callback, universe);
+                    subs->art_dmx(this->getArtDmxData(), size - HEADER_SIZE, metadata, remote_info);
+                    delivered = true;
+                }
+                {
+                    trace::Scope trace_callback(trace::Event::Callback, universe);
+                    if (Routes::dispatch(universe, this->getArtDmxData(), size - HEADER_SIZE, metadata, remote_info)) {
+                        delivered = true;
+                    } else {
+                        trace_callback.cancel();
+                    }
+                }
+                const auto *cb = subs->art_dmx_universes.find(universe);
+                if (cb && *cb) {
+                    trace::Scope trace_callback(trace::Event::Callback, universe);
+                    (*cb)(this->getArtDmxData(), size - HEADER_SIZE, metadata, remote_info);
+                    delivered = true;
+                }
+                this->countUniverse(universe, metadata.sequence, delivered, remote_info.received_us);
+                op_code = OpCode::Dmx;
+                break;
+            }
+#endif
+#if ARTNET_ENABLE_ART_NZS
+            case OpCode::Nzs: {
+                art_nzs::Metadata metadata = art_nzs::generateMetadataFrom(this->packet.data());
+                const uint16_t universe = this->getArtDmxUniverse15bit();
+                trace_dispatch.setUniverse(universe);
+                const auto *cb = subs->art_nzs_universes.find(universe);
+                if (cb && *cb) {
+                    trace::Scope trace_callback(trace::Event::Callback, universe);
+                    (*cb)(this->getArtDmxData(), size - HEADER_SIZE, metadata, remote_info);
+                }
+                this->countUniverse(universe, metadata.sequence, cb && *cb, remote_info.received_us);
+                op_code = OpCode::Nzs;
+                break;
+            }
+#endif
+#if ARTNET_ENABLE_ART_POLL_REPLY
+            case OpCode::Poll: {
+                if (this->art_poll_reply_enabled) {
+                    this->scheduleArtPollReply(remote_info);
+                }
+                op_code = OpCode::Poll;
+                break;
+            }
+#endif
+#if ARTNET_ENABLE_ART_TRIGGER
+            case OpCode::Trigger: {
+                if (subs->art_trigger) {
+                    ArtTriggerMetadata metadata = {
+                        .oem = this->getArtTriggerOEM(),
+                        .key = this->getArtTriggerKey(),
+                        .sub_key = this->getArtTriggerSubKey(),
+                        .payload = this->getArtTriggerPayload(),
+                        .size = static_cast<uint16_t>(size - art_trigger::PAYLOAD),
+                    };
+                    trace::Scope trace_callback(trace::Event::Callback);
+                    subs->art_trigger(metadata, remote_info);
+                }
+                op_code = OpCode::Trigger;
+                break;
+            }
+#endif
+#if ARTNET_ENABLE_ART_SYNC
+            case OpCode::Sync: {
+                if (subs->art_sync) {
+                    trace::Scope trace_callback(trace::Event::Callback);
+                    subs->art_sync(remote_info);
+                }
+#if ARTNET_ENABLE_FASTLED
+                for (const auto &m : subs->fastled_maps) {
+                    m.second.map->sync(remote_info.received_us);
+                }
+#endif
+                op_code = OpCode::Sync;
+                break;
+            }
+#endif
+#if ARTNET_ENABLE_ART_TIMECODE
+            case OpCode::TimeCode: {
+                if (size < art_timecode::PACKET_SIZE) {
+                    logging::debug(this->logger).println(F("ArtTimeCode is too short"));
+                    op_code = OpCode::ParseFailed;
+                    break;
+                }
+                if (subs->art_timecode) {
+                    const ArtTimeCodeMetadata metadata = art_timecode::generateMetadataFrom(this->packet.data());
+                    trace::Scope trace_callback(trace::Event::Callback);
+                    subs->art_timecode(metadata, remote_info);
+                }
+                op_code = OpCode::TimeCode;
+                break;
+            }
+#endif
+            default: {
+                logging::debug(this->logger).print(F("Unsupported OpCode: "));
+                logging::debug(this->logger).println(this->getOpCode(), HEX);
+                op_code = OpCode::Unsupported;
+                break;
+            }
+        }
+        return op_code;
+    }
+
+    void countReceived(OpCode op_code, size_t size)
+    {
+#if ARTNET_ENABLE_STATS
+        this->receive_stats.received.of(op_code).count(size);
+#else
+        (void)op_code;
+        (void)size;
+#endif
+    }
+
+    void countSent(OpCode op_code, size_t size, bool sent)
+    {
+#if ARTNET_ENABLE_STATS
+        this->receive_stats.sent.of(op_code).count(size);
+        if (!sent) {
+            ++this->receive_stats.send_failures;
+        }
+#else
+        (void)op_code;
+        (void)size;
+        (void)sent;
+#endif
+    }
+
+    void countDrop(uint32_t ReceiveDrops::*reason)
+    {
+#if ARTNET_ENABLE_STATS
+        ++(this->receive_stats.drops.*reason);
+#else
+        (void)reason;
+#endif
+    }
+
+    void captureDatagram(CaptureDirection direction, const IPAddress &ip, uint16_t port, uint32_t timestamp_us, const uint8_t *data, size_t size)
+    {
+#if ARTNET_ENABLE_CAPTURE
+        if (this->capture_sink) {
+            this->capture_sink->capture(makeCaptureRecord(direction, ip, port, timestamp_us, size), data);
+        }
+#else
+        (void)direction;
+        (void)ip;
+        (void)port;
+        (void)timestamp_us;
+        (void)data;
+        (void)size;
+#endif
+    }
+
+    void countUniverse(uint16_t universe, uint8_t sequence, bool delivered, uint32_t received_us)
+    {
+#if ARTNET_ENABLE_STATS
+        if (!delivered) {
+            // no entry for unsubscribed universes, otherwise any traffic on the wire fills the table
+            ++this->receive_stats.drops.unsubscribed;
+            (void)received_us;
+            return;
+        }
+        UniverseStats *stats = this->receive_stats.universes.find(universe);
+        if (!stats) {
+            stats = this->receive_stats.universes.insert(universe, UniverseStats());
+        }
+        if (stats) {
+            stats->count(sequence, Clock<S>::millis(), this->receive_stats.drops.stale_sequence);
+#if ARTNET_ENABLE_HISTOGRAMS
+            stats->measure(received_us, Clock<S>::micros());
+#endif
+        }
+        (void)received_us;
+#else
+        (void)universe;
+        (void)sequence;
+        (void)delivered;
+        (void)received_us;
+#endif
+    }
+
+    bool checkID() const
+    {
+        trace::Scope trace_check_id(trace::Event::CheckID);
+        const char* idptr = reinterpret_cast<const char*>(this->packet.data());
+        return !strcmp(ARTNET_ID, idptr);
+    }
+
+    uint16_t getOpCode() const
+    {
+        return (this->packet[art_dmx::OP_CODE_H] << 8) | this->packet[art_dmx::OP_CODE_L];
+    }
+
+    uint16_t getArtDmxUniverse15bit() const
+    {
+        return (this->packet[art_dmx::NET] << 8) | this->packet[art_dmx::SUBUNI];
+    }
+
+    const uint8_t *getArtDmxData() const
+    {
+        return &(this->packet[art_dmx::DATA]);
+    }
+
+#if ARTNET_ENABLE_ART_POLL_REPLY
+    void sendArtPollReply(const RemoteInfo &remote)
+    {
+        trace::Scope trace_send_poll_reply(trace::Event::SendPollReply);
+        this->sendArtPollReplies(remote.ip, [&](const art_poll_reply::Packet &reply, bool sent) {
+            this->countSent(OpCode::PollReply, sizeof(art_poll_reply::Packet), sent);
+            this->captureDatagram(CaptureDirection::Sent, remote.ip, DEFAULT_PORT, Clock<S>::micros(), reply.b, sizeof(art_poll_reply::Packet));
+        });
+    }
+
+    // send ArtPollReply for each subscribed universe and call on_sent(reply, sent) for each of them
+    template <typename F>
+    void sendArtPollReplies(const IPAddress &ip, F &&on_sent)
+    {
+        if (!this->stream) {
+            return;
+        }
+        PollReplyUniverses universes;
+        this->collectArtPollReplyUniverses(universes);
+        art_poll_reply::Packet reply = this->makeArtPollReply();
+        for (const auto &u_pair : universes) {
+            art_poll_reply::setUniverseTo(reply, u_pair.first);
+            on_sent(reply, this->writeArtPollReply(ip, reply));
+        }
+    }
+
+    void processPendingPollReplies()
+    {
+        if (!this->art_poll_reply_enabled) {
+            return;
+        }
+        this->forEachDuePollReply([this](const RemoteInfo &remote) {
+            this->sendArtPollReply(remote);
+        });
+    }
+#endif
+
     uint16_t getArtTriggerOEM() const
     {
         return (this->packet[art_trigger::OEM_H] << 8) | this->packet[art_trigger::OEM_L];
@@ -464,20 +1074,28 @@ private:
 
 };
 
-template <typename S>
+template <typename S, size_t MaxUniverses = DEFAULT_MAX_UNIVERSES, typename Routes = art_dmx::RouteList<>>
 #ifndef ARDUINO_ARCH_AVR
-class Receiver : public IReceiver, public Receiver_<S>
+class Receiver : public IReceiver, public Receiver_<S, MaxUniverses, Routes>
 #else
-class Receiver : public Receiver_<S>
+class Receiver : public Receiver_<S, MaxUniverses, Routes>
 #endif
 {
     S stream;
+    uint8_t packet_buffer[PACKET_SIZE];
+    ReceiverState<MaxUniverses> receiver_state;
 
 public:
+    Receiver()
+    {
+        this->Receiver_<S, MaxUniverses, Routes>::attachPacketBuffer(this->packet_buffer);
+        this->Receiver_<S, MaxUniverses, Routes>::attachState(this->receiver_state);
+    }
+
     void begin(uint16_t recv_port = DEFAULT_PORT)
     {
         this->stream.begin(recv_port);
-        this->Receiver_<S>::attach(this->stream);
+        this->Receiver_<S, MaxUniverses, Routes>::attach(this->stream);
     }
 };
 
@@ -8,6 +8,10 @@
 #include "ArtPollReply.h"
 #include "ArtTrigger.h"
 #include "ArtSync.h"
+#include "ArtTimeCode.h"
+#include "SourceFilter.h"
+#include "Capture.h"
+#include "FastLEDMap.h"
 
 namespace art_net {
 
@@ -33,6 +37,14 @@ bool isNetworkReady(T&& x) {
     return IsNetworkReady<std::decay_t<T>>::get(std::forward<T>(x));
 }
 
+// file descriptor of the stream to wait for datagrams in event loops (e.g. epoll on host)
+// -1 by default because Arduino streams have no file descriptor
+template <typename T>
+struct FileDescriptor
+{
+    static int get(const T&) { return -1; }
+};
+
 template <typename T>
 IPAddress getLocalIP();
 template <typename T>
@@ -47,32 +59,69 @@ struct IReceiver_
     virtual ~IReceiver_() = default;
 
     virtual OpCode parse() = 0;
+    // parse the datagram which is already received
+    virtual OpCode parse(const uint8_t *data, size_t size, const RemoteInfo &remote) = 0;
+    // read one datagram without dispatching
+    virtual size_t receiveRaw(uint8_t *data, size_t size, RemoteInfo &remote) = 0;
+    // send scheduled ArtPollReply (only needed with parse(data, size, remote))
+    virtual void update() = 0;
+    // milliseconds until the next scheduled ArtPollReply (UINT32_MAX if nothing is scheduled)
+    virtual uint32_t nextPollReplyDelayMs() const = 0;
+    // file descriptor of the receive socket (-1 if not available)
+    virtual int fd() const = 0;
+    // false until the network is ready (parse() reads nothing meanwhile)
+    virtual bool isStreamReady() const = 0;
+#if ARTNET_ENABLE_ART_DMX
     // subscribe artdmx packet for specified net, subnet, and universe
     virtual void subscribeArtDmxUniverse(uint8_t net, uint8_t subnet, uint8_t universe, const ArtDmxCallback& func) = 0;
     // subscribe artdmx packet for specified universe (15 bit)
     virtual void subscribeArtDmxUniverse(uint16_t universe, const ArtDmxCallback& func) = 0;
-    // subscribe artnzs packet for specified universe (15 bit)
-    virtual void subscribeArtNzsUniverse(uint16_t universe, const ArtNzsCallback& func) = 0;
     // subscribe artdmx packet for all universes
     virtual void subscribeArtDmx(const ArtDmxCallback& func) = 0;
-    // subscribe other packets
-    virtual void subscribeArtSync(const ArtSyncCallback& func) = 0;
-    // subscribe art_trigger packet
-    virtual void subscribeArtTrigger(const ArtTriggerCallback& func) = 0;
-
     virtual void unsubscribeArtDmxUniverse(uint8_t net, uint8_t subnet, uint8_t universe) = 0;
     virtual void unsubscribeArtDmxUniverse(uint16_t universe) = 0;
     virtual void unsubscribeArtDmxUniverses() = 0;
     virtual void unsubscribeArtDmx() = 0;
+#endif
+#if ARTNET_ENABLE_ART_NZS
+    // subscribe artnzs packet for specified universe (15 bit)
+    virtual void subscribeArtNzsUniverse(uint16_t universe, const ArtNzsCallback& func) = 0;
     virtual void unsubscribeArtNzsUniverse(uint16_t universe) = 0;
+#endif
+#if ARTNET_ENABLE_ART_SYNC
+    // subscribe other packets
+    virtual void subscribeArtSync(const ArtSyncCallback& func) = 0;
     virtual void unsubscribeArtSync() = 0;
+#endif
+#if ARTNET_ENABLE_ART_TRIGGER
+    // subscribe art_trigger packet
+    virtual void subscribeArtTrigger(const ArtTriggerCallback& func) = 0;
     virtual void unsubscribeArtTrigger() = 0;
+#endif
+#if ARTNET_ENABLE_ART_TIMECODE
+    // subscribe art_timecode packet
+    virtual void subscribeArtTimeCode(const ArtTimeCodeCallback& func) = 0;
+    virtual void unsubscribeArtTimeCode() = 0;
+#endif
+
+#if ARTNET_ENABLE_SOURCE_FILTER
+    // accept packets only from the allowed sources (if any source is allowed)
+    virtual bool allowSource(const IPAddress &ip) = 0;
+    // drop packets from the denied sources
+    virtual bool denySource(const IPAddress &ip) = 0;
+    virtual void removeSourceFilter(const IPAddress &ip) = 0;
+    virtual void clearSourceFilters() = 0;
+    virtual SourceFilterDrops sourceFilterDrops() const = 0;
+#endif
 
-#ifdef FASTLED_VERSION
+#if ARTNET_ENABLE_FASTLED
     virtual void forwardArtDmxDataToFastLED(uint8_t net, uint8_t subnet, uint8_t universe, CRGB* leds, uint16_t num) = 0;
     virtual void forwardArtDmxDataToFastLED(uint16_t universe, CRGB* leds, uint16_t num) = 0;
+    virtual void forwardArtDmxDataToFastLED(FastLEDMap &map) = 0;
+    virtual void unforwardArtDmxDataToFastLED(FastLEDMap &map) = 0;
 #endif
 
+#if ARTNET_ENABLE_ART_POLL_REPLY
     // https://art-net.org.uk/how-it-works/discovery-packets/artpollreply/
     virtual void setArtPollReplyConfigOem(uint16_t oem) = 0;
     virtual void setArtPollReplyConfigEstaMan(uint16_t esta_man) = 0;
@@ -95,7 +144,11 @@ struct IReceiver_
         uint8_t sw_in[4]
     ) = 0;
     virtual void setArtPollReplyConfig(const ArtPollReplyConfig &cfg) = 0;
+#endif
     virtual void setLogger(Print* logger) = 0;
+#if ARTNET_ENABLE_CAPTURE
+    virtual void setCaptureSink(ICaptureSink *sink) = 0;
+#endif
 };
 
 struct IReceiver : virtual IReceiver_
@@ -0,0 +1,127 @@
+#pragma once
+#ifndef ARTNET_RING_LOGGER_H
+#define ARTNET_RING_LOGGER_H
+
+#include "Common.h"
+#include <atomic>
+
+namespace art_net {
+
+// Logger which never blocks the receive path (e.g. setLogger(&ring_logger) with ARTNET_LOG_LEVEL_DEBUG)
+// - write() only copies the characters into a preallocated ring buffer
+// - drainTo() prints them to the slow output (e.g. Serial) in small chunks from loop() or other low priority task
+// - lines beyond MaxLinesPerSec, or which do not fit into the ring, are dropped and counted
+// - single producer (the thread which logs) / single consumer (the thread which calls drainTo())
+// Size: bytes of the ring (power of 2)
+template <size_t Size = 1024, uint16_t MaxLinesPerSec = 100>
+class RingLogger : public Print
+{
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "Size of RingLogger should be a power of 2");
+
+    char buffer[Size];
+    std::atomic<size_t> head {0};
+    std::atomic<size_t> tail {0};
+
+    // producer side
+    enum class Line : uint8_t
+    {
+        Accepted,
+        Suppressed,  // dropped by the rate limit
+        Truncated,   // the rest is dropped because the ring was full
+    };
+    uint32_t window_start_ms {0};
+    uint16_t window_lines {0};
+    bool line_started {false};
+    Line line {Line::Accepted};
+    std::atomic<uint32_t> num_dropped_lines {0};
+
+    // consumer side
+    uint32_t reported_dropped_lines {0};
+
+public:
+    size_t write(uint8_t c) override
+    {
+        if (!this->line_started) {
+            this->line_started = true;
+            this->line = this->acquireLine() ? Line::Accepted : Line::Suppressed;
+        }
+        const bool end_of_line = c == '\n';
+        if (end_of_line) {
+            this->line_started = false;
+        }
+        // keep the line break of the truncated line so that the next line is not mixed
+        if (this->line == Line::Suppressed || (this->line == Line::Truncated && !end_of_line)) {
+            return 1;
+        }
+
+        const size_t h = this->head.load(std::memory_order_relaxed);
+        if (h - this->tail.load(std::memory_order_acquire) >= Size) {
+            if (this->line == Line::Accepted) {
+                this->line = Line::Truncated;
+                this->num_dropped_lines.fetch_add(1, std::memory_order_relaxed);
+            }
+            return 1;
+        }
+        this->buffer[h & (Size - 1)] = static_cast<char>(c);
+        this->head.store(h + 1, std::memory_order_release);
+        return 1;
+    }
+    using Print::write;
+
+    /// @brief Print buffered characters to the output (consumer)
+    /// @param max_bytes max number of characters printed in this call (to limit the blocking time)
+    /// @return number of characters printed
+    size_t drainTo(Print &out, size_t max_bytes = 64)
+    {
+        size_t n = 0;
+        size_t t = this->tail.load(std::memory_order_relaxed);
+        const size_t h = this->head.load(std::memory_order_acquire);
+        while (t != h && n < max_bytes) {
+            out.write(static_cast<uint8_t>(this->buffer[t & (Size - 1)]));
+            ++t;
+            ++n;
+        }
+        this->tail.store(t, std::memory_order_release);
+
+        const uint32_t dropped = this->droppedLines();
+        if (t == h && dropped != this->reported_dropped_lines) {
+            out.print(F("[RingLogger] dropped lines: "));
+            out.println(dropped - this->reported_dropped_lines);
+            this->reported_dropped_lines = dropped;
+        }
+        return n;
+    }
+
+    // number of characters waiting to be printed
+    size_t available() const
+    {
+        const size_t t = this->tail.load(std::memory_order_acquire);
+        return this->head.load(std::memory_order_acquire) - t;
+    }
+
+    uint32_t droppedLines() const
+    {
+        return this->num_dropped_lines.load(std::memory_order_relaxed);
+    }
+
+private:
+    // rate limit by the number of lines in every 1 sec window
+    bool acquireLine()
+    {
+        const uint32_t now = millis();
+        if (now - this->window_start_ms >= 1000) {
+            this->window_start_ms = now;
+            this->window_lines = 0;
+        }
+        if (this->window_lines >= MaxLinesPerSec) {
+            this->num_dropped_lines.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        ++this->window_lines;
+        return true;
+    }
+};
+
+} // namespace art_net
+
+#endif // ARTNET_RING_LOGGER_H
@@ -0,0 +1,152 @@
+#pragma once
+#ifndef ARTNET_ROUTER_H
+#define ARTNET_ROUTER_H
+
+#include "Receiver.h"
+#include "Sender.h"
+
+namespace art_net {
+
+// counters of a route
+struct RouteStats
+{
+    uint32_t forwarded {0};      // datagrams sent to the destination
+    uint32_t bytes {0};          // bytes of the forwarded datagrams
+    uint32_t send_failures {0};  // datagrams the stream failed to send
+};
+
+// Art-Net to Art-Net bridge between two interfaces (e.g. wired console on ETH to pixel nodes on WiFi)
+// - route() reads datagrams from the receiver, and ArtDmx / ArtNzs of the routed universes are forwarded
+//   to the destination by the sender as they are, only with the universe and the sequence rewritten in place
+//   (no callback, and no copy of the payload)
+// - other datagrams (ArtPoll, ArtSync, unrouted universes, etc.) are dispatched by the receiver as usual
+// - the sequence is counted per route (1 - 255), or kept 0 if the source disabled it
+// Receiver / Sender: e.g. ArtnetETHReceiver / ArtnetWiFiSender, or Manager of each interface
+// MaxRoutes: capacity of the routes (input universes)
+// NOTE: add / remove routes on the thread which calls route()
+template <typename Receiver, typename Sender, size_t MaxRoutes = DEFAULT_MAX_UNIVERSES>
+class Router
+{
+    struct Route
+    {
+        String ip;
+        uint16_t universe;
+        uint8_t sequence;
+        RouteStats stats;
+    };
+
+    Receiver &receiver;
+    Sender &sender;
+    FlatMap<uint16_t, Route, MaxRoutes> routes;
+    uint8_t buffer[PACKET_SIZE];
+    uint32_t num_local {0};
+
+public:
+    Router(Receiver &r, Sender &s)
+    : receiver(r), sender(s)
+    {
+    }
+
+    /// @brief Forward the universe (15 bit) received by the receiver to ip as to_universe (the route is replaced if it exists)
+    /// @return false if the route table is full
+    bool addRoute(uint16_t from_universe, const String &ip, uint16_t to_universe)
+    {
+        return this->routes.insert(from_universe, Route {ip, static_cast<uint16_t>(to_universe & 0x7FFF), 0, RouteStats()}) != nullptr;
+    }
+    bool addRoute(uint16_t universe, const String &ip)
+    {
+        return this->addRoute(universe, ip, universe);
+    }
+
+    void removeRoute(uint16_t from_universe)
+    {
+        this->routes.erase(from_universe);
+    }
+
+    void clearRoutes()
+    {
+        this->routes.clear();
+    }
+
+    size_t numRoutes() const
+    {
+        return this->routes.size();
+    }
+
+    /// @brief Read the received datagrams, forward the routed ones and dispatch the others
+    /// @param max_packets max number of datagrams to read in this call
+    /// @return number of datagrams read
+    size_t route(size_t max_packets = 16)
+    {
+        size_t n = 0;
+        for (; n < max_packets; ++n) {
+            RemoteInfo remote;
+            const size_t size = this->receiver.receiveRaw(this->buffer, sizeof(this->buffer), remote);
+            if (size == 0) {
+                break;
+            }
+            if (!this->forward(size)) {
+                this->receiver.parse(this->buffer, size, remote);
+                ++this->num_local;
+            }
+        }
+        this->receiver.update();
+        return n;
+    }
+
+    // counters of the route (nullptr if the universe is not routed)
+    const RouteStats *routeStats(uint16_t from_universe) const
+    {
+        const Route *r = this->routes.find(from_universe);
+        return r ? &r->stats : nullptr;
+    }
+
+    // number of datagrams dispatched by the receiver (not forwarded)
+    uint32_t localPackets() const
+    {
+        return this->num_local;
+    }
+
+    void resetRouteStats()
+    {
+        for (auto &r : this->routes) {
+            r.second.stats = RouteStats();
+        }
+        this->num_local = 0;
+    }
+
+private:
+    bool forward(size_t size)
+    {
+        if (size <= HEADER_SIZE || memcmp(this->buffer, ARTNET_ID, ID_LENGTH) != 0) {
+            return false;
+        }
+        // ArtDmx and ArtNzs have the same layout of the sequence and the universe
+        const OpCode op_code = static_cast<OpCode>((this->buffer[art_dmx::OP_CODE_H] << 8) | this->buffer[art_dmx::OP_CODE_L]);
+        if (op_code != OpCode::Dmx && op_code != OpCode::Nzs) {
+            return false;
+        }
+        const uint16_t universe = ((this->buffer[art_dmx::NET] & 0x7F) << 8) | this->buffer[art_dmx::SUBUNI];
+        Route *r = this->routes.find(universe);
+        if (!r) {
+            return false;
+        }
+        if (this->buffer[art_dmx::SEQUENCE] != 0) {
+            r->sequence = r->sequence == 255 ? 1 : r->sequence + 1;
+            this->buffer[art_dmx::SEQUENCE] = r->sequence;
+        }
+        this->buffer[art_dmx::NET] = static_cast<uint8_t>(r->universe >> 8);
+        this->buffer[art_dmx::SUBUNI] = static_cast<uint8_t>(r->universe);
+        if (this->sender.sendRaw(r->ip, this->buffer, size)) {
+            ++r->stats.forwarded;
+            r->stats.bytes += static_cast<uint32_t>(size);
+        } else {
+            ++r->stats.send_failures;
+        }
+        return true;
+    }
+};
+
+} // namespace art_net
+
+#endif // ARTNET_ROUTER_H
@@ -7,42 +7,53 @@
 #include "ArtNzs.h"
 #include "ArtTrigger.h"
 #include "ArtSync.h"
+#include "ArtTimeCode.h"
 #include "SenderTraits.h"
-#include <PollingTimer.h>
+#include "Stats.h"
+#include "Trace.h"
+#include "Clock.h"
+#include "Capture.h"
 
 namespace art_net {
 
-template <typename S>
+// Runtime table of Sender_ (sequences and streaming timers of the destinations)
+// Sender keeps it inline, and Manager keeps it in one block with the tables of Receiver_ (see ManagerState)
+template <size_t MaxDestinations>
+struct SenderState
+{
+    // NOTE: the ip is copied into the fixed size entry when a new destination is registered (no heap)
+    DestinationStateMap<MaxDestinations> destinations;
+};
+
+// MaxDestinations: capacity of destinations (ip, net, subnet, universe) to keep sequences and streaming intervals
+template <typename S, size_t MaxDestinations = DEFAULT_MAX_DESTINATIONS>
 #ifndef ARDUINO_ARCH_AVR
 class Sender_ : virtual ISender_
 #else
 class Sender_
 #endif
 {
-    S* stream;
-    Array<PACKET_SIZE> packet;
-    PollingTimer timer;
-    LastSendTimeMsMap last_send_times;
-    SequenceMap dmx_sequences;
-    SequenceMap nzs_sequences;
-
-public:
-#if ARX_HAVE_LIBSTDCPLUSPLUS >= 201103L  // Have libstdc++11
-#else
-    Sender_()
-    {
-        this->packet.resize(PACKET_SIZE);
-        this->timer.start();
-    }
+    S* stream {nullptr};
+    PacketRef packet;
+    SenderState<MaxDestinations> *tables {nullptr};
+#if ARTNET_ENABLE_STATS
+    SenderStats send_stats;
+#endif
+#if ARTNET_ENABLE_CAPTURE
+    ICaptureSink *capture_sink {nullptr};
 #endif
 
+public:
+#if ARTNET_ENABLE_ART_DMX
     // streaming artdmx packet
     void setArtDmxData(const uint8_t* const data, uint16_t size)
     {
+        this->packet.claim(PacketOwner::Sender);
         art_dmx::setDataTo(this->packet.data(), data, size);
     }
     void setArtDmxData(uint16_t ch, uint8_t data)
     {
+        this->packet.claim(PacketOwner::Sender);
         art_dmx::setDataTo(this->packet.data(), ch, data);
     }
 
@@ -59,24 +70,33 @@ public:
     }
     void streamArtDmxTo(const String& ip, uint8_t net, uint8_t subnet, uint8_t universe, uint8_t physical)
     {
-        Destination dest {ip, net, subnet, universe};
-        double now = timer.msec();
-        if (this->last_send_times.find(dest) == this->last_send_times.end()) {
-            this->last_send_times.insert(std::make_pair(dest, 0.0));
+        DestinationKey dest {ip.c_str(), net, subnet, universe};
+        DestinationState *state = this->findOrInsertDestination(dest);
+        if (!state) {
+            return;
         }
-        if (now >= this->last_send_times[dest] + DEFAULT_INTERVAL_MS) {
-            this->sendArxDmxInternal(dest, physical);
-            this->last_send_times[dest] = now;
+        const uint32_t now = Clock<S>::millis();
+        if (!state->streamed || isDue(now, state->last_send_time_ms, static_cast<uint32_t>(DEFAULT_INTERVAL_MS))) {
+            if (!this->hasStagedData()) {
+                return;
+            }
+            this->sendArxDmxInternal(dest, state, physical);
+            state->last_send_time_ms = now;
+            state->streamed = true;
         }
     }
+#endif
 
+#if ARTNET_ENABLE_ART_NZS
     // streaming artnzs packet
     void setArtNzsData(const uint8_t* const data, uint16_t size)
     {
+        this->packet.claim(PacketOwner::Sender);
         art_nzs::setDataTo(this->packet.data(), data, size);
     }
     void setArtNzsData(uint16_t ch, uint8_t data)
     {
+        this->packet.claim(PacketOwner::Sender);
         art_nzs::setDataTo(this->packet.data(), ch, data);
     }
 
@@ -93,17 +113,24 @@ public:
     }
     void streamArtNzsTo(const String& ip, uint8_t net, uint8_t subnet, uint8_t universe, uint8_t start_code)
     {
-        Destination dest {ip, net, subnet, universe};
-        double now = timer.msec();
-        if (this->last_send_times.find(dest) == this->last_send_times.end()) {
-            this->last_send_times.insert(std::make_pair(dest, 0.0));
+        DestinationKey dest {ip.c_str(), net, subnet, universe};
+        DestinationState *state = this->findOrInsertDestination(dest);
+        if (!state) {
+            return;
         }
-        if (now >= this->last_send_times[dest] + DEFAULT_INTERVAL_MS) {
-            this->sendArxNzsInternal(dest, start_code);
-            this->last_send_times[dest] = now;
+        const uint32_t now = Clock<S>::millis();
+        if (!state->streamed || isDue(now, state->last_send_time_ms, static_cast<uint32_t>(DEFAULT_INTERVAL_MS))) {
+            if (!this->hasStagedData()) {
+                return;
+            }
+            this->sendArxNzsInternal(dest, state, start_code);
+            state->last_send_time_ms = now;
+            state->streamed = true;
         }
     }
+#endif
 
+#if ARTNET_ENABLE_ART_DMX
     // one-line artdmx sender
     void sendArtDmx(const String& ip, uint16_t universe15bit, const uint8_t* const data, uint16_t size)
     {
@@ -118,11 +145,13 @@ public:
     }
     void sendArtDmx(const String& ip, uint8_t net, uint8_t subnet, uint8_t universe, uint8_t physical, const uint8_t *data, uint16_t size)
     {
-        Destination dest {ip, net, subnet, universe};
+        DestinationKey dest {ip.c_str(), net, subnet, universe};
         this->setArtDmxData(data, size);
-        this->sendArxDmxInternal(dest, physical);
+        this->sendArxDmxInternal(dest, this->findOrInsertDestination(dest), physical);
     }
+#endif
 
+#if ARTNET_ENABLE_ART_NZS
     // one-line artnzs sender
     void sendArtNzs(const String& ip, uint16_t universe15bit, const uint8_t* const data, uint16_t size)
     {
@@ -137,22 +166,84 @@ public:
     }
     void sendArtNzs(const String& ip, uint8_t net, uint8_t subnet, uint8_t universe, uint8_t start_code, const uint8_t *data, uint16_t size)
     {
-        Destination dest {ip, net, subnet, universe};
+        DestinationKey dest {ip.c_str(), net, subnet, universe};
         this->setArtNzsData(data, size);
-        this->sendArxNzsInternal(dest, start_code);
+        this->sendArxNzsInternal(dest, this->findOrInsertDestination(dest), start_code);
     }
+#endif
 
+#if ARTNET_ENABLE_ART_TRIGGER
     void sendArtTrigger(const String& ip, uint16_t oem = 0, uint8_t key = 0, uint8_t subkey = 0, const uint8_t *payload = nullptr, uint16_t size = 512)
     {
         art_trigger::setDataTo(packet.data(), oem, key, subkey, payload, size);
-        this->sendRawData(ip, DEFAULT_PORT, packet.data(), packet.size());
+        this->sendRawData(ip.c_str(), DEFAULT_PORT, packet.data(), packet.size());
     }
+#endif
 
+#if ARTNET_ENABLE_ART_SYNC
     void sendArtSync(const String& ip)
     {
         art_sync::setMetadataTo(packet.data());
-        this->sendRawData(ip, DEFAULT_PORT, packet.data(), art_sync::PACKET_SIZE);
+        this->sendRawData(ip.c_str(), DEFAULT_PORT, packet.data(), art_sync::PACKET_SIZE);
+    }
+#endif
+
+#if ARTNET_ENABLE_ART_TIMECODE
+    void sendArtTimeCode(const String& ip, uint8_t hours, uint8_t minutes, uint8_t seconds, uint8_t frames, ArtTimeCodeType type, uint8_t stream_id = 0)
+    {
+        this->sendArtTimeCode(ip, ArtTimeCodeMetadata {hours, minutes, seconds, frames, type, stream_id});
+    }
+    void sendArtTimeCode(const String& ip, const ArtTimeCodeMetadata &timecode)
+    {
+        art_timecode::setDataTo(packet.data(), timecode);
+        this->sendRawData(ip.c_str(), DEFAULT_PORT, packet.data(), art_timecode::PACKET_SIZE);
+    }
+#endif
+
+    /// @brief Send an Art-Net datagram as it is (e.g. forwarded by Router), counted and captured like other packets
+    /// @return false if the stream failed to send it
+    bool sendRaw(const String& ip, const uint8_t *data, size_t size, uint16_t port = DEFAULT_PORT)
+    {
+        if (!this->stream || size <= art_dmx::OP_CODE_H || !isNetworkReady<S>()) {
+            return false;
+        }
+        return this->sendRawData(ip.c_str(), port, data, size);
+    }
+
+#if ARTNET_ENABLE_STATS
+    // counters of the packets sent and send failures
+    const SenderStats &senderStats() const
+    {
+        return this->send_stats;
+    }
+    void resetSenderStats()
+    {
+        this->send_stats = SenderStats();
+    }
+#endif
+
+    // gather the packets sent between beginFrame() and endFrame() (e.g. all universes of a frame)
+    // and send them at once if the stream supports batched send (e.g. one sendmmsg() call on host)
+    void beginFrame()
+    {
+        if (this->stream) {
+            SendBatch<S>::begin(*this->stream);
+        }
+    }
+    void endFrame()
+    {
+        if (this->stream) {
+            SendBatch<S>::end(*this->stream);
+        }
+    }
+
+#if ARTNET_ENABLE_CAPTURE
+    // copy the sent datagrams to the sink (e.g. CaptureRing), nullptr to stop
+    void setCaptureSink(ICaptureSink *sink)
+    {
+        this->capture_sink = sink;
     }
+#endif
 
 protected:
     void attach(S& s)
@@ -160,56 +251,127 @@ protected:
         this->stream = &s;
     }
 
-    void sendArxDmxInternal(const Destination &dest, uint8_t physical)
+    void attachPacketBuffer(uint8_t *buffer, PacketOwner *owner = nullptr)
+    {
+        this->packet.attach(buffer, owner);
+    }
+
+    // table owned by the derived class (attach before sending)
+    void attachState(SenderState<MaxDestinations> &s)
+    {
+        this->tables = &s;
+    }
+
+#if ARTNET_ENABLE_ART_DMX
+    // state: nullptr if the destination table is full, then sent without sequence (0 means sequence is disabled)
+    void sendArxDmxInternal(const DestinationKey &dest, DestinationState *state, uint8_t physical)
     {
         if (!isNetworkReady<S>()) {
             return;
         }
 
-        if (this->dmx_sequences.find(dest) == this->dmx_sequences.end()) {
-            this->dmx_sequences.insert(std::make_pair(dest, uint8_t(0)));
-        }
-        art_dmx::setMetadataTo(this->packet.data(), this->dmx_sequences[dest], physical, dest.net, dest.subnet, dest.universe);
+        uint8_t sequence = state ? state->dmx_sequence : 0;
+        art_dmx::setMetadataTo(this->packet.data(), sequence, physical, dest.net, dest.subnet, dest.universe);
         this->sendRawData(dest.ip, DEFAULT_PORT, this->packet.data(), this->packet.size());
-        this->dmx_sequences[dest] = (this->dmx_sequences[dest] + 1) % 256;
+        if (state) {
+            state->dmx_sequence = (state->dmx_sequence + 1) % 256;
+        }
     }
+#endif
 
-    void sendArxNzsInternal(const Destination &dest, uint8_t start_code)
+#if ARTNET_ENABLE_ART_NZS
+    // state: nullptr if the destination table is full, then sent without sequence (0 means sequence is disabled)
+    void sendArxNzsInternal(const DestinationKey &dest, DestinationState *state, uint8_t start_code)
     {
         if (!isNetworkReady<S>()) {
             return;
         }
 
-        if (this->nzs_sequences.find(dest) == this->nzs_sequences.end()) {
-            this->nzs_sequences.insert(std::make_pair(dest, uint8_t(0)));
-        }
-        art_nzs::setMetadataTo(this->packet.data(), this->nzs_sequences[dest], start_code, dest.net, dest.subnet, dest.universe);
+        uint8_t sequence = state ? state->nzs_sequence : 0;
+        art_nzs::setMetadataTo(this->packet.data(), sequence, start_code, dest.net, dest.subnet, dest.universe);
         this->sendRawData(dest.ip, DEFAULT_PORT, this->packet.data(), this->packet.size());
-        this->nzs_sequences[dest] = (this->nzs_sequences[dest] + 1) % 256;
+        if (state) {
+            state->nzs_sequence = (state->nzs_sequence + 1) % 256;
+        }
+    }
+#endif
+
+    // false if parse() of the integrated receiver overwrote the data set by setArtDmxData() / setArtNzsData()
+    // in the shared packet buffer (then the received frame would be sent again)
+    bool hasStagedData()
+    {
+        if (this->packet.ownedBy(PacketOwner::Sender)) {
+            return true;
+        }
+#if ARTNET_ENABLE_STATS
+        ++this->send_stats.stale_data;
+#endif
+        return false;
+    }
+
+    // nullptr if the table is full or the ip is longer than an IPv4 address (e.g. host name)
+    DestinationState *findOrInsertDestination(const DestinationKey &dest)
+    {
+        DestinationState *state = this->tables->destinations.find(dest);
+        if (state) {
+            return state;
+        }
+        const size_t ip_length = strlen(dest.ip);
+        if (ip_length > DESTINATION_IP_LENGTH) {
+            return nullptr;
+        }
+        Destination d {{}, dest.net, dest.subnet, dest.universe};
+        memcpy(d.ip, dest.ip, ip_length + 1);
+        return this->tables->destinations.insert(d, DestinationState());
     }
 
-    void sendRawData(const String& ip, uint16_t port, const uint8_t* const data, size_t size)
+    bool sendRawData(const char *ip, uint16_t port, const uint8_t* const data, size_t size)
     {
-        this->stream->beginPacket(ip.c_str(), port);
+        const OpCode op_code = static_cast<OpCode>((data[art_dmx::OP_CODE_H] << 8) | data[art_dmx::OP_CODE_L]);
+        const bool has_universe = op_code == OpCode::Dmx || op_code == OpCode::Nzs;
+        trace::Scope trace_send_raw_data(trace::Event::SendRawData, has_universe ? (data[art_dmx::NET] << 8) | data[art_dmx::SUBUNI] : trace::NO_UNIVERSE);
+        const int began = this->stream->beginPacket(ip, port);
         this->stream->write(data, size);
-        this->stream->endPacket();
+        const int sent = this->stream->endPacket();
+#if ARTNET_ENABLE_CAPTURE
+        if (this->capture_sink) {
+            CaptureRecord record = makeCaptureRecord(CaptureDirection::Sent, IPAddress(), port, Clock<S>::micros(), size);
+            parseCaptureAddress(ip, record.ip);
+            this->capture_sink->capture(record, data);
+        }
+#endif
+#if ARTNET_ENABLE_STATS
+        this->send_stats.sent.of(op_code).count(size);
+        if (!began || !sent) {
+            ++this->send_stats.send_failures;
+        }
+#endif
+        return began && sent;
     }
 };
 
-template <typename S>
+template <typename S, size_t MaxDestinations = DEFAULT_MAX_DESTINATIONS>
 #ifndef ARDUINO_ARCH_AVR
-class Sender : public ISender, public Sender_<S>
+class Sender : public ISender, public Sender_<S, MaxDestinations>
 #else
-class Sender : public Sender_<S>
+class Sender : public Sender_<S, MaxDestinations>
 #endif
 {
     S stream;
+    uint8_t packet_buffer[PACKET_SIZE];
+    SenderState<MaxDestinations> sender_state;
 
 public:
+    Sender()
+    {
+        this->Sender_<S, MaxDestinations>::attachPacketBuffer(this->packet_buffer);
+        this->Sender_<S, MaxDestinations>::attachState(this->sender_state);
+    }
+
     void begin(uint16_t send_port = DEFAULT_PORT)
     {
         this->stream.begin(send_port);
-        this->Sender_<S>::attach(this->stream);
+        this->Sender_<S, MaxDestinations>::attach(this->stream);
     }
 };
 
@@ -2,12 +2,24 @@
 #ifndef ARTNET_SENDER_TRAITS_H
 #define ARTNET_SENDER_TRAITS_H
 
+#include "Capture.h"
+
 namespace art_net {
 
+// Batched send of the stream (e.g. sendmmsg() on host)
+// By default, packets are sent one by one and beginFrame() / endFrame() of Sender do nothing
+template <typename T>
+struct SendBatch
+{
+    static void begin(T&) {}
+    static void end(T&) {}
+};
+
 struct ISender_
 {
     virtual ~ISender_() = default;
 
+#if ARTNET_ENABLE_ART_DMX
     // streaming artdmx packet
     virtual void setArtDmxData(const uint8_t* const data, uint16_t size) = 0;
     virtual void setArtDmxData(uint16_t ch, uint8_t data) = 0;
@@ -15,7 +27,9 @@ struct ISender_
     virtual void streamArtDmxTo(const String& ip, uint16_t universe15bit) = 0;
     virtual void streamArtDmxTo(const String& ip, uint8_t net, uint8_t subnet, uint8_t universe) = 0;
     virtual void streamArtDmxTo(const String& ip, uint8_t net, uint8_t subnet, uint8_t universe, uint8_t physical) = 0;
+#endif
 
+#if ARTNET_ENABLE_ART_NZS
     // streaming artnzs packet
     virtual void setArtNzsData(const uint8_t* const data, uint16_t size) = 0;
     virtual void setArtNzsData(uint16_t ch, uint8_t data) = 0;
@@ -23,20 +37,45 @@ struct ISender_
     virtual void streamArtNzsTo(const String& ip, uint16_t universe15bit) = 0;
     virtual void streamArtNzsTo(const String& ip, uint8_t net, uint8_t subnet, uint8_t universe) = 0;
     virtual void streamArtNzsTo(const String& ip, uint8_t net, uint8_t subnet, uint8_t universe, uint8_t start_code) = 0;
+#endif
 
+#if ARTNET_ENABLE_ART_DMX
     // one-line artdmx sender
     virtual void sendArtDmx(const String& ip, uint16_t universe15bit, const uint8_t* const data, uint16_t size) = 0;
     virtual void sendArtDmx(const String& ip, uint8_t net, uint8_t subnet, uint8_t universe, const uint8_t* const data, uint16_t size) = 0;
     virtual void sendArtDmx(const String& ip, uint8_t net, uint8_t subnet, uint8_t universe, uint8_t physical, const uint8_t *data, uint16_t size) = 0;
+#endif
 
+#if ARTNET_ENABLE_ART_NZS
     // one-line artnzs sender
     virtual void sendArtNzs(const String& ip, uint16_t universe15bit, const uint8_t* const data, uint16_t size) = 0;
     virtual void sendArtNzs(const String& ip, uint8_t net, uint8_t subnet, uint8_t universe, const uint8_t* const data, uint16_t size) = 0;
     virtual void sendArtNzs(const String& ip, uint8_t net, uint8_t subnet, uint8_t universe, uint8_t start_code, const uint8_t *data, uint16_t size) = 0;
+#endif
 
+#if ARTNET_ENABLE_ART_TRIGGER
     virtual void sendArtTrigger(const String& ip, uint16_t oem = 0, uint8_t key = 0, uint8_t subkey = 0, const uint8_t *payload = nullptr, uint16_t size = 512) = 0;
+#endif
 
+#if ARTNET_ENABLE_ART_SYNC
     virtual void sendArtSync(const String& ip) = 0;
+#endif
+
+#if ARTNET_ENABLE_ART_TIMECODE
+    virtual void sendArtTimeCode(const String& ip, uint8_t hours, uint8_t minutes, uint8_t seconds, uint8_t frames, ArtTimeCodeType type, uint8_t stream_id = 0) = 0;
+    virtual void sendArtTimeCode(const String& ip, const ArtTimeCodeMetadata &timecode) = 0;
+#endif
+
+    // send an Art-Net datagram as it is
+    virtual bool sendRaw(const String& ip, const uint8_t *data, size_t size, uint16_t port = DEFAULT_PORT) = 0;
+
+    // gather the packets sent between beginFrame() and endFrame() if the stream supports batched send
+    virtual void beginFrame() = 0;
+    virtual void endFrame() = 0;
+
+#if ARTNET_ENABLE_CAPTURE
+    virtual void setCaptureSink(ICaptureSink *sink) = 0;
+#endif
 };
 
 struct ISender : virtual ISender_
@@ -0,0 +1,176 @@
+#pragma once
+#ifndef ARTNET_SNAPSHOT_TABLE_H
+#define ARTNET_SNAPSHOT_TABLE_H
+
+#include "Common.h"
+#if ARTNET_THREAD_SAFE_SUBSCRIPTIONS
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace art_net {
+
+#if ARTNET_THREAD_SAFE_SUBSCRIPTIONS
+
+// Callback stored in SnapshotTable: the copy made by update() only shares it (no heap allocation),
+// and it is destroyed when the last snapshot which has it is overwritten
+template <typename F>
+class SnapshotCallback
+{
+    std::shared_ptr<const F> func;
+
+public:
+    SnapshotCallback() = default;
+    SnapshotCallback(std::nullptr_t) {}
+    SnapshotCallback(const F &f) : func(f ? std::make_shared<const F>(f) : nullptr) {}
+
+    explicit operator bool() const { return static_cast<bool>(this->func); }
+
+    template <typename... Args>
+    void operator()(Args &&...args) const
+    {
+        (*this->func)(std::forward<Args>(args)...);
+    }
+};
+
+// Table which is read by one dispatch thread and updated by any threads (RCU-style triple buffer)
+// - reader: acquire() an immutable snapshot without locks and release() it after use
+// - writers: update() a copy of the current snapshot and publish it by one atomic store.
+//   Writers never wait for the reader because the copy is made into the buffer which is neither
+//   the current one nor the one held by the reader. Writers are serialized by a mutex among themselves
+//   (it blocks instead of spinning, so a preempted low priority writer is not starved on RTOS)
+// - update() can also be called from the callbacks running on the reader thread
+// - synchronize() waits until the reader drops the snapshots older than the current one (grace period)
+// NOTE: update() copies the whole table, so keep callbacks in SnapshotCallback to avoid heap allocation by the copy
+template <typename T>
+class SnapshotTable
+{
+    static constexpr uint8_t NONE {0xFF};
+
+    T buffers[3];
+    std::atomic<uint8_t> current {0};
+    std::atomic<uint8_t> held {NONE};
+    std::atomic<std::thread::id> reader {};
+    std::mutex writer_mutex;
+
+public:
+    // for the dispatch thread only
+    const T &acquire()
+    {
+        this->reader.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        uint8_t index = this->current.load();
+        while (true) {
+            this->held.store(index);
+            // if a writer published a new snapshot before it saw the held index, retry with it
+            const uint8_t latest = this->current.load();
+            if (latest == index) {
+                return this->buffers[index];
+            }
+            index = latest;
+        }
+    }
+
+    void release()
+    {
+        this->held.store(NONE);
+    }
+
+    /// @brief Apply func(T&) to a copy of the current snapshot and publish it
+    /// @return return value of func
+    template <typename F>
+    auto update(F &&func) -> decltype(func(std::declval<T &>()))
+    {
+        this->writer_mutex.lock();
+        const uint8_t index = this->current.load();
+        const uint8_t reading = this->held.load();
+        uint8_t next = 0;
+        while (next == index || next == reading) {
+            ++next;
+        }
+        this->buffers[next] = this->buffers[index];
+        Publisher publisher {this, next};
+        return func(this->buffers[next]);
+    }
+
+    /// @brief Wait until the reader holds no snapshot older than the current one
+    /// After this returns, what was removed by the previous update() is never used by the reader
+    /// (e.g. the objects referred by an unsubscribed callback can be destroyed)
+    /// @note returns immediately on the reader thread (e.g. in a callback), because the reader cannot wait for itself
+    void synchronize()
+    {
+        if (this->reader.load(std::memory_order_relaxed) == std::this_thread::get_id()) {
+            return;
+        }
+        while (true) {
+            const uint8_t h = this->held.load();
+            if (h == NONE || h == this->current.load()) {
+                return;
+            }
+            // sleep rather than yield so that a lower priority reader can run on RTOS
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+private:
+    // publish the updated buffer and unlock after func() returns (also for void func)
+    struct Publisher
+    {
+        SnapshotTable *table;
+        uint8_t index;
+        ~Publisher()
+        {
+            this->table->current.store(this->index);
+            this->table->writer_mutex.unlock();
+        }
+    };
+};
+
+#else
+
+// Single-threaded version: the table is updated in place, and callbacks are stored as they are
+template <typename F>
+using SnapshotCallback = F;
+
+template <typename T>
+class SnapshotTable
+{
+    T table;
+
+public:
+    const T &acquire() { return this->table; }
+    void release() {}
+
+    template <typename F>
+    auto update(F &&func) -> decltype(func(std::declval<T &>()))
+    {
+        return func(this->table);
+    }
+
+    void synchronize() {}
+};
+
+#endif
+
+// RAII reader of the snapshot (release() on destruction)
+template <typename T>
+class SnapshotReader
+{
+    SnapshotTable<T> &table;
+    const T &snapshot;
+
+public:
+    explicit SnapshotReader(SnapshotTable<T> &table) : table(table), snapshot(table.acquire()) {}
+    ~SnapshotReader() { this->table.release(); }
+    SnapshotReader(const SnapshotReader &) = delete;
+    SnapshotReader &operator=(const SnapshotReader &) = delete;
+
+    const T &operator*() const { return this->snapshot; }
+    const T *operator->() const { return &this->snapshot; }
+};
+
+} // namespace art_net
+
+#endif // ARTNET_SNAPSHOT_TABLE_H
@@ -0,0 +1,137 @@
+#pragma once
+#ifndef ARTNET_SOURCE_FILTER_H
+#define ARTNET_SOURCE_FILTER_H
+
+#include "Common.h"
+#include "FlatMap.h"
+
+namespace art_net {
+
+enum class SourceFilterResult : uint8_t
+{
+    Accepted,
+    Denied,      // source is in the deny list
+    NotAllowed,  // allow list is not empty and the source is not in it
+};
+
+struct SourceFilterDrops
+{
+    uint32_t denied;
+    uint32_t not_allowed;
+};
+
+// Allow / deny list of source IP addresses checked before reading the payload
+// - entries are stored in a fixed size sorted array (binary search, no heap allocation)
+// - deny list: packets from these sources are dropped
+// - allow list: if not empty, only packets from these sources are accepted
+template <size_t Capacity>
+class SourceFilter
+{
+    FlatMap<uint32_t, bool, Capacity> entries;  // value: true = allow, false = deny
+    size_t num_allowed {0};
+    SourceFilterDrops num_drops {0, 0};
+
+public:
+    static constexpr size_t capacity() { return Capacity; }
+
+    // returns false if the list is full
+    bool allow(const IPAddress &ip)
+    {
+        return this->set(ip, true);
+    }
+
+    // returns false if the list is full
+    bool deny(const IPAddress &ip)
+    {
+        return this->set(ip, false);
+    }
+
+    void remove(const IPAddress &ip)
+    {
+        const uint32_t key = keyOf(ip);
+        const bool *allowed = this->entries.find(key);
+        if (allowed) {
+            if (*allowed) {
+                --this->num_allowed;
+            }
+            this->entries.erase(key);
+        }
+    }
+
+    void clear()
+    {
+        this->entries.clear();
+        this->num_allowed = 0;
+    }
+
+    bool empty() const
+    {
+        return this->entries.empty();
+    }
+
+    // check the source and count the drop
+    SourceFilterResult check(const IPAddress &ip)
+    {
+        const SourceFilterResult result = this->lookup(ip);
+        if (result == SourceFilterResult::Denied) {
+            ++this->num_drops.denied;
+        } else if (result == SourceFilterResult::NotAllowed) {
+            ++this->num_drops.not_allowed;
+        }
+        return result;
+    }
+
+    // check the source without counting the drop
+    SourceFilterResult lookup(const IPAddress &ip) const
+    {
+        if (this->entries.empty()) {
+            return SourceFilterResult::Accepted;
+        }
+        const bool *allowed = this->entries.find(keyOf(ip));
+        if (allowed && !*allowed) {
+            return SourceFilterResult::Denied;
+        }
+        if (this->num_allowed > 0 && !allowed) {
+            return SourceFilterResult::NotAllowed;
+        }
+        return SourceFilterResult::Accepted;
+    }
+
+    const SourceFilterDrops &drops() const
+    {
+        return this->num_drops;
+    }
+
+    void resetDrops()
+    {
+        this->num_drops = {0, 0};
+    }
+
+private:
+    bool set(const IPAddress &ip, bool allowed)
+    {
+        const uint32_t key = keyOf(ip);
+        const bool *prev = this->entries.find(key);
+        const bool was_allowed = prev && *prev;
+        if (!this->entries.insert(key, allowed)) {
+            return false;
+        }
+        if (allowed && !was_allowed) {
+            ++this->num_allowed;
+        } else if (!allowed && was_allowed) {
+            --this->num_allowed;
+        }
+        return true;
+    }
+
+    static uint32_t keyOf(const IPAddress &ip)
+    {
+        return ((uint32_t)ip[0] << 24) | ((uint32_t)ip[1] << 16) | ((uint32_t)ip[2] << 8) | (uint32_t)ip[3];
+    }
+};
+
+} // namespace art_net
+
+using ArtNetSourceFilterDrops = art_net::SourceFilterDrops;
+
+#endif // ARTNET_SOURCE_FILTER_H
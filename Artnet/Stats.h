@@ -0,0 +1,194 @@
+#pragma once
+#ifndef ARTNET_STATS_H
+#define ARTNET_STATS_H
+
+#include "Common.h"
+#include "FlatMap.h"
+
+namespace art_net {
+
+struct PacketCounter
+{
+    uint32_t packets {0};
+    uint32_t bytes {0};
+
+    void count(size_t size)
+    {
+        ++this->packets;
+        this->bytes += static_cast<uint32_t>(size);
+    }
+};
+
+// Counters of the packets per opcode
+struct OpCodeCounters
+{
+    PacketCounter dmx {};
+    PacketCounter nzs {};
+    PacketCounter poll {};
+    PacketCounter poll_reply {};
+    PacketCounter sync {};
+    PacketCounter trigger {};
+    PacketCounter timecode {};
+    PacketCounter other {};
+
+    PacketCounter &of(OpCode op_code)
+    {
+        switch (op_code) {
+            case OpCode::Dmx: return this->dmx;
+            case OpCode::Nzs: return this->nzs;
+            case OpCode::Poll: return this->poll;
+            case OpCode::PollReply: return this->poll_reply;
+            case OpCode::Sync: return this->sync;
+            case OpCode::Trigger: return this->trigger;
+            case OpCode::TimeCode: return this->timecode;
+            default: return this->other;
+        }
+    }
+};
+
+// Histogram of durations in microseconds with fixed log2 buckets (no allocation, O(1) to add)
+// bucket 0: < 16 us, bucket i: [16 << (i - 1), 16 << i) us, last bucket: >= 16 << (NUM_BUCKETS - 2) us (262 ms)
+struct Histogram
+{
+    static constexpr size_t NUM_BUCKETS {16};
+
+    uint32_t buckets[NUM_BUCKETS] {};
+    uint32_t count {0};
+    uint32_t max_us {0};
+
+    static size_t bucketOf(uint32_t us)
+    {
+        size_t i = 0;
+        for (uint32_t v = us >> 4; v != 0 && i < NUM_BUCKETS - 1; v >>= 1) {
+            ++i;
+        }
+        return i;
+    }
+
+    // upper bound of the bucket (UINT32_MAX for the last bucket)
+    static uint32_t upperBoundUs(size_t i)
+    {
+        return i + 1 < NUM_BUCKETS ? (uint32_t)16 << i : UINT32_MAX;
+    }
+
+    void add(uint32_t us)
+    {
+        ++this->buckets[bucketOf(us)];
+        ++this->count;
+        if (us > this->max_us) {
+            this->max_us = us;
+        }
+    }
+
+    /// @brief Approximate percentile (upper bound of the bucket which contains it)
+    /// @param percent 0 - 100 (e.g. 50 for median, 99 for p99)
+    uint32_t percentileUs(uint8_t percent) const
+    {
+        if (this->count == 0) {
+            return 0;
+        }
+        const uint32_t rank = (uint32_t)((uint64_t)this->count * percent / 100);
+        uint32_t sum = 0;
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            sum += this->buckets[i];
+            if (sum > rank) {
+                const uint32_t upper = upperBoundUs(i);
+                return upper < this->max_us ? upper : this->max_us;
+            }
+        }
+        return this->max_us;
+    }
+};
+
+// Receive statistics of ArtDmx / ArtNzs for each universe
+struct UniverseStats
+{
+    uint32_t packets {0};
+    uint32_t last_seen_ms {0};    // millis() when the last packet has arrived
+    uint16_t fps {0};             // packets per second measured over the last window (about 1 sec)
+    uint16_t window_packets {0};
+    uint32_t window_start_ms {0};
+    uint32_t stale_sequence {0};  // packets whose sequence is older than the previous one
+    uint8_t last_sequence {0};
+#if ARTNET_ENABLE_HISTOGRAMS
+    Histogram interval;           // inter-arrival time of the packets
+    Histogram latency;            // from the arrival to the return of the callbacks
+    uint32_t jitter_us {0};       // smoothed deviation of the inter-arrival time (like RFC 3550)
+    uint32_t last_received_us {0};
+    uint32_t last_interval_us {0};
+#endif
+
+    void count(uint8_t sequence, uint32_t now_ms, uint32_t &stale_total)
+    {
+        if (this->packets == 0) {
+            this->window_start_ms = now_ms;
+        } else if (sequence != 0 && this->last_sequence != 0 && static_cast<int8_t>(sequence - this->last_sequence) < 0) {
+            ++this->stale_sequence;
+            ++stale_total;
+        }
+        ++this->packets;
+        ++this->window_packets;
+        this->last_seen_ms = now_ms;
+        this->last_sequence = sequence;
+        const uint32_t elapsed = now_ms - this->window_start_ms;
+        if (elapsed >= 1000) {
+            this->fps = static_cast<uint16_t>((uint32_t)this->window_packets * 1000 / elapsed);
+            this->window_packets = 0;
+            this->window_start_ms = now_ms;
+        }
+    }
+
+#if ARTNET_ENABLE_HISTOGRAMS
+    // call after count() with the arrival time of the packet and micros() after the callbacks returned
+    void measure(uint32_t received_us, uint32_t done_us)
+    {
+        this->latency.add(done_us - received_us);
+        if (this->packets > 1) {
+            const uint32_t interval_us = received_us - this->last_received_us;
+            this->interval.add(interval_us);
+            if (this->packets > 2) {
+                const uint32_t d = interval_us > this->last_interval_us ? interval_us - this->last_interval_us : this->last_interval_us - interval_us;
+                // J += (|D| - J) / 16
+                this->jitter_us = d > this->jitter_us ? this->jitter_us + (d - this->jitter_us) / 16 : this->jitter_us - (this->jitter_us - d) / 16;
+            }
+            this->last_interval_us = interval_us;
+        }
+        this->last_received_us = received_us;
+    }
+#endif
+};
+
+// Counters of the packets which were not delivered to the callbacks as they were
+struct ReceiveDrops
+{
+    uint32_t bad_id {0};          // not Art-Net packet (dropped)
+    uint32_t oversize {0};        // larger than PACKET_SIZE (truncated)
+    uint32_t unsubscribed {0};    // ArtDmx / ArtNzs for the universe without callbacks (dropped)
+    uint32_t filtered {0};        // dropped by the source filter
+    uint32_t stale_sequence {0};  // sequence is older than the previous one of the universe (still dispatched)
+};
+
+// Statistics of Receiver_ (updated on the thread which calls parse())
+template <size_t MaxUniverses>
+struct ReceiverStats
+{
+    OpCodeCounters received {};
+    OpCodeCounters sent {};  // ArtPollReply
+    ReceiveDrops drops {};
+    uint32_t send_failures {0};   // endPacket() returned 0
+    // subscribed universes which are received, in the order of universe (new universes are ignored if full)
+    // universes without callbacks are counted only by drops.unsubscribed
+    FlatMap<uint16_t, UniverseStats, MaxUniverses> universes;
+};
+
+// Statistics of Sender_
+struct SenderStats
+{
+    OpCodeCounters sent {};
+    uint32_t send_failures {0};   // beginPacket() or endPacket() returned 0
+    uint32_t stale_data {0};      // streamArtDmxTo() / streamArtNzsTo() skipped because parse() overwrote the shared buffer
+};
+
+} // namespace art_net
+
+#endif // ARTNET_STATS_H
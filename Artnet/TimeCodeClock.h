@@ -0,0 +1,182 @@
+#pragma once
+#ifndef ARTNET_TIMECODE_CLOCK_H
+#define ARTNET_TIMECODE_CLOCK_H
+
+#include "ArtTimeCode.h"
+#include "Clock.h"
+
+namespace art_net {
+
+// Local timebase locked to the ArtTimeCode of a console (clock recovery)
+// Packet arrival jitters by the network, so the position is predicted from the local clock and corrected by
+// a small part of the error on each packet (type-II loop: phase and rate), which gives a smooth timecode
+// between packets and follows the drift of the console clock.
+// - jump (locate), change of the type, or resume after stop: locks to the received timecode immediately
+// - same timecode repeated (paused): holds the position
+// - no packet for the timeout: holds the position where the timecode stopped
+// e.g.)
+//   artnet.subscribeArtTimeCode([&](const ArtTimeCodeMetadata &tc, const ArtNetRemoteInfo &remote) {
+//       timecode_clock.update(tc, remote.received_us);
+//   });
+//   uint64_t position_us = timecode_clock.positionUs(micros());
+class TimeCodeClock
+{
+    static constexpr int32_t MAX_DRIFT_PPM {50000};
+    // divisors of the error applied to the phase / rate on each packet
+    static constexpr int32_t PHASE_GAIN {16};
+    static constexpr int32_t RATE_GAIN {256};
+
+    bool locked {false};
+    bool paused {false};
+    art_timecode::Type timecode_type {art_timecode::Type::EBU};
+    uint32_t timeout_ms {500};
+
+    // position = anchor_tc_us + elapsed from anchor_local_us (corrected by rate_ppm)
+    uint32_t anchor_local_us {0};
+    uint64_t anchor_tc_us {0};
+    int32_t rate_ppm {0};
+
+    uint64_t last_tc_us {0};
+    uint32_t last_received_us {0};
+    uint32_t jitter_us {0};
+
+public:
+    /// @brief Feed a received timecode
+    /// @param received_us local micros() when the packet was received (e.g. ArtNetRemoteInfo::received_us)
+    void update(const ArtTimeCodeMetadata &tc, uint32_t received_us)
+    {
+        if (!art_timecode::isValid(tc)) {
+            return;
+        }
+        const uint64_t measured = art_timecode::framesToMicros(art_timecode::toFrameCount(tc), tc.type);
+        if (!this->locked || tc.type != this->timecode_type) {
+            this->lock(tc.type, measured, received_us);
+        } else if (measured == this->last_tc_us) {
+            if (!this->paused) {
+                this->paused = true;
+                this->anchor_tc_us = measured;
+                this->anchor_local_us = received_us;
+            }
+        } else if (this->paused || isDue(received_us, this->last_received_us, this->timeout_ms * 1000)) {
+            this->lock(tc.type, measured, received_us);
+        } else {
+            const uint32_t elapsed_us = elapsed(received_us, this->anchor_local_us);
+            const uint64_t predicted = this->predict(elapsed_us);
+            const int64_t error = static_cast<int64_t>(measured) - static_cast<int64_t>(predicted);
+            const int64_t max_error = static_cast<int64_t>(2 * art_timecode::framesToMicros(1, tc.type));
+            if (error > max_error || error < -max_error) {
+                this->lock(tc.type, measured, received_us);
+            } else {
+                this->anchor_tc_us = static_cast<uint64_t>(static_cast<int64_t>(predicted) + error / PHASE_GAIN);
+                this->anchor_local_us = received_us;
+                if (elapsed_us > 0) {
+                    const int64_t rate = this->rate_ppm + error * 1000000 / static_cast<int64_t>(elapsed_us) / RATE_GAIN;
+                    this->rate_ppm = static_cast<int32_t>(rate > MAX_DRIFT_PPM ? MAX_DRIFT_PPM : rate < -MAX_DRIFT_PPM ? -MAX_DRIFT_PPM : rate);
+                }
+                const int64_t abs_error = error < 0 ? -error : error;
+                this->jitter_us = static_cast<uint32_t>(this->jitter_us + (abs_error - static_cast<int64_t>(this->jitter_us)) / 16);
+            }
+        }
+        this->last_tc_us = measured;
+        this->last_received_us = received_us;
+    }
+
+    // position in microseconds from 00:00:00:00 at the local time now_us (e.g. micros())
+    uint64_t positionUs(uint32_t now_us) const
+    {
+        if (!this->locked || this->paused) {
+            return this->anchor_tc_us;
+        }
+        // freewheel until the timeout, then hold
+        uint32_t since_last_us = elapsed(now_us, this->last_received_us);
+        if (since_last_us > this->timeout_ms * 1000) {
+            since_last_us = this->timeout_ms * 1000;
+        }
+        return this->predict(elapsed(this->last_received_us, this->anchor_local_us) + since_last_us);
+    }
+
+    // frames from 00:00:00:00 at now_us
+    uint32_t frameCountAt(uint32_t now_us) const
+    {
+        return art_timecode::microsToFrames(this->positionUs(now_us), this->timecode_type);
+    }
+
+    // timecode (hours, minutes, seconds, frames) at now_us
+    ArtTimeCodeMetadata timeCodeAt(uint32_t now_us) const
+    {
+        return art_timecode::fromFrameCount(this->frameCountAt(now_us), this->timecode_type);
+    }
+
+    // microseconds until the next frame starts (to schedule the rendering of the frame)
+    uint32_t microsToNextFrame(uint32_t now_us) const
+    {
+        const uint64_t position = this->positionUs(now_us);
+        const uint64_t next = art_timecode::framesToMicros(art_timecode::microsToFrames(position, this->timecode_type) + 1, this->timecode_type);
+        const uint64_t remaining = next > position ? next - position : 0;
+        return static_cast<uint32_t>(remaining * 1000000 / static_cast<uint64_t>(1000000 + this->rate_ppm));
+    }
+
+    bool isLocked() const
+    {
+        return this->locked;
+    }
+
+    // false if paused or no timecode is received for the timeout
+    bool isRunning(uint32_t now_us) const
+    {
+        return this->locked && !this->paused && !isDue(now_us, this->last_received_us, this->timeout_ms * 1000);
+    }
+
+    art_timecode::Type type() const
+    {
+        return this->timecode_type;
+    }
+
+    // rate of the console clock relative to the local clock
+    int32_t driftPpm() const
+    {
+        return this->rate_ppm;
+    }
+
+    // smoothed error between the received timecode and the prediction (network jitter)
+    uint32_t jitterUs() const
+    {
+        return this->jitter_us;
+    }
+
+    void setTimeoutMs(uint32_t ms)
+    {
+        this->timeout_ms = ms;
+    }
+
+    // unlock and forget the drift (the timeout is kept)
+    void reset()
+    {
+        const uint32_t timeout = this->timeout_ms;
+        *this = TimeCodeClock();
+        this->timeout_ms = timeout;
+    }
+
+private:
+    void lock(art_timecode::Type type, uint64_t measured, uint32_t received_us)
+    {
+        this->locked = true;
+        this->paused = false;
+        this->timecode_type = type;
+        this->anchor_tc_us = measured;
+        this->anchor_local_us = received_us;
+        this->jitter_us = 0;
+    }
+
+    uint64_t predict(uint32_t elapsed_us) const
+    {
+        const int64_t corrected = static_cast<int64_t>(elapsed_us) + static_cast<int64_t>(elapsed_us) * this->rate_ppm / 1000000;
+        return this->anchor_tc_us + static_cast<uint64_t>(corrected > 0 ? corrected : 0);
+    }
+};
+
+} // namespace art_net
+
+using ArtTimeCodeClock = art_net::TimeCodeClock;
+
+#endif // ARTNET_TIMECODE_CLOCK_H
@@ -0,0 +1,163 @@
+#pragma once
+#ifndef ARTNET_TRACE_H
+#define ARTNET_TRACE_H
+
+#include "Common.h"
+#if ARTNET_ENABLE_TRACE
+#include <atomic>
+#endif
+
+namespace art_net {
+namespace trace {
+
+enum class Event : uint8_t
+{
+    ParsePacket,    // stream->parsePacket() which returned a datagram
+    Read,           // stream->read() of the datagram
+    CheckID,        // check of "Art-Net" ID
+    Dispatch,       // whole dispatch of the packet (including callbacks)
+    Callback,       // each user callback
+    SendPollReply,  // sendArtPollReply()
+    SendRawData,    // Sender_::sendRawData()
+};
+
+inline const char *nameOf(Event event)
+{
+    switch (event) {
+        case Event::ParsePacket: return "parsePacket";
+        case Event::Read: return "read";
+        case Event::CheckID: return "checkID";
+        case Event::Dispatch: return "dispatch";
+        case Event::Callback: return "callback";
+        case Event::SendPollReply: return "sendArtPollReply";
+        case Event::SendRawData: return "sendRawData";
+        default: return "unknown";
+    }
+}
+
+constexpr uint16_t NO_UNIVERSE {0xFFFF};
+
+// one complete event (begin time and duration)
+struct Record
+{
+    uint32_t begin_us;
+    uint32_t duration_us;
+    uint16_t universe;
+    Event event;
+    uint8_t thread;
+};
+
+#if ARTNET_ENABLE_TRACE
+
+// Ring of the latest ARTNET_TRACE_BUFFER_SIZE records (oldest records are overwritten)
+// Records can be added from any threads without locks. Read them by snapshot() when the receiver is quiet
+// (records being written during snapshot() can be torn).
+class Buffer
+{
+    static constexpr size_t SIZE {ARTNET_TRACE_BUFFER_SIZE};
+    static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0, "ARTNET_TRACE_BUFFER_SIZE should be a power of 2");
+
+    Record records[SIZE];
+    std::atomic<uint32_t> next {0};
+
+public:
+    void add(const Record &record)
+    {
+        const uint32_t i = this->next.fetch_add(1, std::memory_order_relaxed);
+        this->records[i & (SIZE - 1)] = record;
+    }
+
+    /// @brief Copy the records from the oldest one
+    /// @return number of records copied
+    size_t snapshot(Record *out, size_t max_records) const
+    {
+        const uint32_t end = this->next.load(std::memory_order_acquire);
+        const uint32_t num = end < SIZE ? end : SIZE;
+        const size_t n = num < max_records ? num : max_records;
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = this->records[(end - n + i) & (SIZE - 1)];
+        }
+        return n;
+    }
+
+    // number of records added since start (or clear())
+    uint32_t total() const
+    {
+        return this->next.load(std::memory_order_relaxed);
+    }
+
+    static constexpr size_t capacity() { return SIZE; }
+
+    void clear()
+    {
+        this->next.store(0, std::memory_order_relaxed);
+    }
+};
+
+inline Buffer &buffer()
+{
+    static Buffer b;
+    return b;
+}
+
+inline uint8_t threadId()
+{
+#if defined(ESP_PLATFORM)
+    return static_cast<uint8_t>(xPortGetCoreID());
+#elif !defined(ARDUINO)
+    static std::atomic<uint8_t> num_threads {0};
+    static thread_local uint8_t id = num_threads.fetch_add(1, std::memory_order_relaxed);
+    return id;
+#else
+    return 0;
+#endif
+}
+
+// Records the duration from the construction to the destruction
+class Scope
+{
+    uint32_t begin_us;
+    uint16_t universe;
+    Event event;
+    bool active {true};
+
+public:
+    explicit Scope(Event event, uint16_t universe = NO_UNIVERSE) : begin_us(micros()), universe(universe), event(event) {}
+    ~Scope()
+    {
+        this->end();
+    }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    void setUniverse(uint16_t u) { this->universe = u; }
+    // do not record (e.g. parsePacket() returned nothing)
+    void cancel() { this->active = false; }
+    // record now instead of at the end of the scope
+    void end()
+    {
+        if (this->active) {
+            this->active = false;
+            buffer().add(Record {this->begin_us, micros() - this->begin_us, this->universe, this->event, threadId()});
+        }
+    }
+};
+
+#else
+
+// compiled to nothing if ARTNET_ENABLE_TRACE is 0
+class Scope
+{
+public:
+    explicit Scope(Event, uint16_t = NO_UNIVERSE) {}
+    void setUniverse(uint16_t) {}
+    void cancel() {}
+    void end() {}
+};
+
+#endif
+
+} // namespace trace
+} // namespace art_net
+
+#endif // ARTNET_TRACE_H
@@ -0,0 +1,280 @@
+#pragma once
+#ifndef ARTNET_HOST_ARDUINO_SHIM_H
+#define ARTNET_HOST_ARDUINO_SHIM_H
+
+// Minimal subset of Arduino APIs (String, IPAddress, Print, millis, etc.) to build this library on host (Linux/POSIX)
+// NOTE: This is not a complete Arduino core. Only the APIs used by this library and its host tools are provided.
+
+#ifdef ARDUINO
+#error "Artnet/host/ArduinoShim.h is only for host (non-Arduino) builds"
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+// strings are not placed in flash on host
+#define F(string_literal) (string_literal)
+
+class String
+{
+    std::string s;
+
+public:
+    String() = default;
+    String(const char *cstr) : s(cstr ? cstr : "") {}
+    String(const std::string &str) : s(str) {}
+    explicit String(char c) : s(1, c) {}
+    explicit String(int value, unsigned char base = DEC) : s(toString(static_cast<long long>(value), base)) {}
+    explicit String(unsigned int value, unsigned char base = DEC) : s(toString(static_cast<unsigned long long>(value), base)) {}
+    explicit String(long value, unsigned char base = DEC) : s(toString(static_cast<long long>(value), base)) {}
+    explicit String(unsigned long value, unsigned char base = DEC) : s(toString(static_cast<unsigned long long>(value), base)) {}
+    explicit String(double value, unsigned char digits = 2)
+    {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.*f", digits, value);
+        this->s = buf;
+    }
+
+    const char *c_str() const { return this->s.c_str(); }
+    unsigned int length() const { return static_cast<unsigned int>(this->s.length()); }
+    bool isEmpty() const { return this->s.empty(); }
+    char operator[](unsigned int index) const { return index < this->s.length() ? this->s[index] : 0; }
+    char charAt(unsigned int index) const { return (*this)[index]; }
+
+    bool concat(const String &str) { this->s += str.s; return true; }
+    bool concat(const char *cstr) { if (cstr) this->s += cstr; return cstr != nullptr; }
+    bool concat(char c) { this->s += c; return true; }
+    String &operator+=(const String &rhs) { this->concat(rhs); return *this; }
+    String &operator+=(const char *cstr) { this->concat(cstr); return *this; }
+    String &operator+=(char c) { this->concat(c); return *this; }
+
+    int compareTo(const String &rhs) const { return this->s.compare(rhs.s); }
+    bool equals(const String &rhs) const { return this->s == rhs.s; }
+    bool startsWith(const String &prefix) const { return this->s.compare(0, prefix.s.length(), prefix.s) == 0; }
+    int indexOf(char c, unsigned int from = 0) const
+    {
+        const size_t i = this->s.find(c, from);
+        return i == std::string::npos ? -1 : static_cast<int>(i);
+    }
+    String substring(unsigned int from, unsigned int to) const { return String(this->s.substr(from, to > from ? to - from : 0)); }
+    String substring(unsigned int from) const { return String(this->s.substr(from < this->s.length() ? from : this->s.length())); }
+    long toInt() const { return strtol(this->s.c_str(), nullptr, 10); }
+    const std::string &str() const { return this->s; }
+
+    friend bool operator==(const String &a, const String &b) { return a.s == b.s; }
+    friend bool operator!=(const String &a, const String &b) { return a.s != b.s; }
+    friend bool operator<(const String &a, const String &b) { return a.s < b.s; }
+    friend bool operator>(const String &a, const String &b) { return a.s > b.s; }
+    friend bool operator<=(const String &a, const String &b) { return a.s <= b.s; }
+    friend bool operator>=(const String &a, const String &b) { return a.s >= b.s; }
+    friend String operator+(const String &a, const String &b) { return String(a.s + b.s); }
+    friend String operator+(const String &a, const char *b) { return String(a.s + (b ? b : "")); }
+    friend String operator+(const char *a, const String &b) { return String((a ? a : "") + b.s); }
+
+private:
+    static std::string toString(unsigned long long value, unsigned char base)
+    {
+        if (base < 2 || base > 36) {
+            base = DEC;
+        }
+        char buf[72];
+        char *p = buf + sizeof(buf) - 1;
+        *p = '\0';
+        do {
+            const unsigned digit = static_cast<unsigned>(value % base);
+            *--p = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+            value /= base;
+        } while (value);
+        return std::string(p);
+    }
+    static std::string toString(long long value, unsigned char base)
+    {
+        if (value < 0 && base == DEC) {
+            return "-" + toString(static_cast<unsigned long long>(-value), base);
+        }
+        return toString(static_cast<unsigned long long>(value), base);
+    }
+};
+
+class IPAddress
+{
+    uint8_t bytes[4] {0, 0, 0, 0};
+
+public:
+    IPAddress() = default;
+    IPAddress(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3) : bytes {b0, b1, b2, b3} {}
+    // network byte order (same as Arduino)
+    IPAddress(uint32_t address) { memcpy(this->bytes, &address, 4); }
+    IPAddress(const uint8_t *address) { memcpy(this->bytes, address, 4); }
+
+    operator uint32_t() const
+    {
+        uint32_t address;
+        memcpy(&address, this->bytes, 4);
+        return address;
+    }
+    bool operator==(const IPAddress &rhs) const { return memcmp(this->bytes, rhs.bytes, 4) == 0; }
+    bool operator!=(const IPAddress &rhs) const { return !(*this == rhs); }
+    uint8_t operator[](int index) const { return this->bytes[index]; }
+    uint8_t &operator[](int index) { return this->bytes[index]; }
+    const uint8_t *raw_address() const { return this->bytes; }
+
+    bool fromString(const char *address)
+    {
+        unsigned int b[4];
+        char tail;
+        if (!address || sscanf(address, "%u.%u.%u.%u%c", &b[0], &b[1], &b[2], &b[3], &tail) != 4) {
+            return false;
+        }
+        for (size_t i = 0; i < 4; ++i) {
+            if (b[i] > 255) {
+                return false;
+            }
+            this->bytes[i] = static_cast<uint8_t>(b[i]);
+        }
+        return true;
+    }
+    bool fromString(const String &address) { return this->fromString(address.c_str()); }
+
+    String toString() const
+    {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", this->bytes[0], this->bytes[1], this->bytes[2], this->bytes[3]);
+        return String(buf);
+    }
+};
+
+class Print
+{
+public:
+    virtual ~Print() = default;
+
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+        size_t n = 0;
+        while (size--) {
+            if (this->write(*buffer++)) {
+                ++n;
+            } else {
+                break;
+            }
+        }
+        return n;
+    }
+    size_t write(const char *str) { return str ? this->write(reinterpret_cast<const uint8_t *>(str), strlen(str)) : 0; }
+    virtual void flush() {}
+
+    size_t print(const char *str) { return this->write(str); }
+    size_t print(const String &str) { return this->write(str.c_str()); }
+    size_t print(char c) { return this->write(static_cast<uint8_t>(c)); }
+    size_t print(unsigned char value, int base = DEC) { return this->print(static_cast<unsigned long>(value), base); }
+    size_t print(int value, int base = DEC) { return this->print(static_cast<long>(value), base); }
+    size_t print(unsigned int value, int base = DEC) { return this->print(static_cast<unsigned long>(value), base); }
+    size_t print(long value, int base = DEC) { return this->print(String(value, static_cast<unsigned char>(base))); }
+    size_t print(unsigned long value, int base = DEC) { return this->print(String(value, static_cast<unsigned char>(base))); }
+    size_t print(long long value, int base = DEC) { return this->print(static_cast<long>(value), base); }
+    size_t print(unsigned long long value, int base = DEC) { return this->print(static_cast<unsigned long>(value), base); }
+    size_t print(double value, int digits = 2) { return this->print(String(value, static_cast<unsigned char>(digits))); }
+    size_t print(const IPAddress &ip) { return this->print(ip.toString()); }
+
+    size_t println() { return this->write("\r\n"); }
+    template <typename T>
+    size_t println(const T &value) { return this->print(value) + this->println(); }
+    template <typename T>
+    size_t println(const T &value, int base_or_digits) { return this->print(value, base_or_digits) + this->println(); }
+};
+
+// Print to stdout (e.g. setLogger(&Serial))
+class StdoutPrint : public Print
+{
+public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+    size_t write(const uint8_t *buffer, size_t size) override { return fwrite(buffer, 1, size, stdout); }
+    using Print::write;
+    void flush() override { fflush(stdout); }
+};
+
+inline StdoutPrint Serial;
+
+namespace art_net {
+namespace host {
+
+inline std::chrono::steady_clock::time_point startTime()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return start;
+}
+
+inline std::mt19937 &randomEngine()
+{
+    static std::mt19937 engine {std::random_device {}()};
+    return engine;
+}
+
+} // namespace host
+} // namespace art_net
+
+// NOTE: Same as Arduino, these values wrap around (millis() after about 49 days)
+inline uint32_t millis()
+{
+    using namespace std::chrono;
+    return static_cast<uint32_t>(duration_cast<milliseconds>(steady_clock::now() - art_net::host::startTime()).count());
+}
+
+inline uint32_t micros()
+{
+    using namespace std::chrono;
+    return static_cast<uint32_t>(duration_cast<microseconds>(steady_clock::now() - art_net::host::startTime()).count());
+}
+
+inline void delay(uint32_t ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+inline void delayMicroseconds(uint32_t us)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+inline void yield()
+{
+    std::this_thread::yield();
+}
+
+inline void randomSeed(unsigned long seed)
+{
+    art_net::host::randomEngine().seed(static_cast<std::mt19937::result_type>(seed));
+}
+
+inline long random(long max)
+{
+    if (max <= 0) {
+        return 0;
+    }
+    return std::uniform_int_distribution<long>(0, max - 1)(art_net::host::randomEngine());
+}
+
+inline long random(long min, long max)
+{
+    if (min >= max) {
+        return min;
+    }
+    return min + random(max - min);
+}
+
+#endif // ARTNET_HOST_ARDUINO_SHIM_H
@@ -0,0 +1,121 @@
+#pragma once
+#ifndef ARTNET_HOST_CAPTURE_WRITER_H
+#define ARTNET_HOST_CAPTURE_WRITER_H
+
+#include "../Capture.h"
+#include "Pcap.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace art_net {
+namespace host {
+
+#if ARTNET_ENABLE_CAPTURE
+
+// Background thread which drains a CaptureRing into a pcap file
+// Sender / Receiver only copy datagrams into the ring, so file I/O never blocks the hot path.
+// Timestamps (micros() of the records) are converted to the wall clock at start().
+// Received datagrams are written as remote -> local_ip:local_port, and sent ones as local_ip:local_port -> remote.
+template <typename Ring>
+class PcapCaptureWriter
+{
+    Ring *ring {nullptr};
+    PcapWriter writer;
+    std::thread thread;
+    std::atomic<bool> running {false};
+    std::atomic<uint64_t> num_written {0};
+
+    IPAddress local_ip;
+    uint16_t local_port {DEFAULT_PORT};
+
+    // micros() -> wall clock (records may come from several threads slightly out of order)
+    uint64_t wall_start_us {0};
+    uint32_t last_timestamp_us {0};
+    int64_t elapsed_us {0};
+
+public:
+    PcapCaptureWriter() = default;
+    PcapCaptureWriter(const PcapCaptureWriter &) = delete;
+    PcapCaptureWriter &operator=(const PcapCaptureWriter &) = delete;
+    ~PcapCaptureWriter()
+    {
+        this->stop();
+    }
+
+    /// @brief Open the file and start the thread which drains the ring every interval_ms
+    /// @return false if the file cannot be opened
+    bool start(Ring &r, const char *path, const IPAddress &ip = IPAddress(), uint16_t port = DEFAULT_PORT, uint32_t interval_ms = 10)
+    {
+        this->stop();
+        if (!this->writer.open(path)) {
+            return false;
+        }
+        this->ring = &r;
+        this->local_ip = ip;
+        this->local_port = port;
+        this->wall_start_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        this->last_timestamp_us = ::micros();
+        this->elapsed_us = 0;
+        this->running = true;
+        this->thread = std::thread([this, interval_ms] {
+            while (this->running) {
+                this->drain();
+                std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+            }
+        });
+        return true;
+    }
+
+    // write the rest of the ring and close the file
+    void stop()
+    {
+        if (this->thread.joinable()) {
+            this->running = false;
+            this->thread.join();
+        }
+        if (this->writer.isOpen()) {
+            this->drain();
+            this->writer.close();
+        }
+    }
+
+    // number of datagrams written to the file
+    uint64_t written() const
+    {
+        return this->num_written.load(std::memory_order_relaxed);
+    }
+
+private:
+    void drain()
+    {
+        CaptureRecord record;
+        uint8_t data[PACKET_SIZE];
+        bool any = false;
+        while (this->ring->read(record, data, sizeof(data))) {
+            this->elapsed_us += static_cast<int32_t>(record.timestamp_us - this->last_timestamp_us);
+            this->last_timestamp_us = record.timestamp_us;
+            const uint64_t timestamp_us = this->wall_start_us + static_cast<uint64_t>(this->elapsed_us > 0 ? this->elapsed_us : 0);
+            const size_t size = record.size < sizeof(data) ? record.size : sizeof(data);
+            const IPAddress remote(record.ip[0], record.ip[1], record.ip[2], record.ip[3]);
+            const bool ok = record.direction == CaptureDirection::Received
+                ? this->writer.write(timestamp_us, remote, record.port, this->local_ip, this->local_port, data, size)
+                : this->writer.write(timestamp_us, this->local_ip, this->local_port, remote, record.port, data, size);
+            if (ok) {
+                this->num_written.fetch_add(1, std::memory_order_relaxed);
+            }
+            any = true;
+        }
+        if (any) {
+            this->writer.flush();
+        }
+    }
+};
+
+#endif
+
+} // namespace host
+} // namespace art_net
+
+#endif // ARTNET_HOST_CAPTURE_WRITER_H
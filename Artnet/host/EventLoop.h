@@ -0,0 +1,267 @@
+#pragma once
+#ifndef ARTNET_HOST_EVENT_LOOP_H
+#define ARTNET_HOST_EVENT_LOOP_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace art_net {
+namespace host {
+
+// epoll based run loop instead of polling parse() in a busy loop (Linux only)
+// - sleeps until datagrams arrive or the next ArtPollReply is due, then drains the socket in batch
+// - a receiver which hit max_batch is drained again without waiting because epoll cannot see
+//   datagrams already buffered in user space (e.g. by recvmmsg in PosixUDPBatch)
+// - a receiver whose network is not ready is unwatched for NOT_READY_BACKOFF_MS instead of spinning on the readable fd
+// - other file descriptors (timers, pipes, etc.) can be added with their callbacks
+// NOTE: callbacks run on the thread which calls run() / runOnce(). stop() can be called from any thread.
+class EventLoop
+{
+    // result of on_readable
+    enum class Drain
+    {
+        Empty,     // nothing left to read
+        More,      // stopped at max_batch (call again without waiting)
+        NotReady,  // nothing could be read yet (back off)
+    };
+
+    struct Source
+    {
+        int fd;
+        std::function<Drain()> on_readable;
+        std::function<uint32_t()> next_timeout_ms;  // optional
+        std::function<void()> on_timeout;           // optional
+        bool pending;
+        bool paused;
+        uint32_t paused_at_ms;
+    };
+
+    int epoll_fd {-1};
+    int wakeup_fd {-1};
+    std::vector<Source> sources;
+    std::vector<size_t> pending_indices;
+    std::atomic<bool> stopped {false};
+
+public:
+    static constexpr uint32_t NOT_READY_BACKOFF_MS {100};
+
+    EventLoop()
+    {
+        this->epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+        this->wakeup_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (this->epoll_fd >= 0 && this->wakeup_fd >= 0) {
+            epoll_event ev {};
+            ev.events = EPOLLIN;
+            ev.data.u64 = UINT64_MAX;
+            ::epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, this->wakeup_fd, &ev);
+        }
+    }
+    EventLoop(const EventLoop &) = delete;
+    EventLoop &operator=(const EventLoop &) = delete;
+    ~EventLoop()
+    {
+        if (this->wakeup_fd >= 0) {
+            ::close(this->wakeup_fd);
+        }
+        if (this->epoll_fd >= 0) {
+            ::close(this->epoll_fd);
+        }
+    }
+
+    /// @brief Watch the file descriptor
+    /// @param on_readable called when the fd becomes readable
+    /// @param next_timeout_ms returns milliseconds until on_timeout should be called (UINT32_MAX if nothing)
+    /// @return false if the fd could not be added
+    bool add(int fd, const std::function<void()> &on_readable, const std::function<uint32_t()> &next_timeout_ms = nullptr, const std::function<void()> &on_timeout = nullptr)
+    {
+        if (!on_readable) {
+            return false;
+        }
+        return this->addSource(
+            fd,
+            [on_readable] {
+                on_readable();
+                return Drain::Empty;
+            },
+            next_timeout_ms,
+            on_timeout);
+    }
+
+    /// @brief Watch the receive socket of Receiver / Manager (call after begin())
+    /// @param max_batch max number of datagrams parsed in one wakeup (to be fair with other sources)
+    template <typename R>
+    bool add(R &receiver, size_t max_batch = 256)
+    {
+        return this->addSource(
+            receiver.fd(),
+            [&receiver, max_batch] {
+                if (!receiver.isStreamReady()) {
+                    return Drain::NotReady;
+                }
+                for (size_t i = 0; i < max_batch; ++i) {
+                    if (receiver.parse() == OpCode::NoPacket) {
+                        return Drain::Empty;
+                    }
+                }
+                return Drain::More;
+            },
+            [&receiver] {
+                return receiver.nextPollReplyDelayMs();
+            },
+            [&receiver] {
+                receiver.update();
+            });
+    }
+
+    /// @brief Wait for events once and dispatch them
+    /// @param max_timeout_ms upper limit of the wait (-1: until events or timeouts)
+    /// @return number of sources which were readable
+    int runOnce(int max_timeout_ms = -1)
+    {
+        const uint32_t now_ms = this->millis();
+        int timeout_ms = max_timeout_ms;
+        for (size_t i = 0; i < this->sources.size(); ++i) {
+            const Source &source = this->sources[i];
+            if (source.paused) {
+                const uint32_t elapsed = now_ms - source.paused_at_ms;
+                if (elapsed >= NOT_READY_BACKOFF_MS) {
+                    this->resume(i);
+                } else if (timeout_ms < 0 || NOT_READY_BACKOFF_MS - elapsed < static_cast<uint32_t>(timeout_ms)) {
+                    timeout_ms = static_cast<int>(NOT_READY_BACKOFF_MS - elapsed);
+                }
+            }
+            if (this->sources[i].pending) {
+                timeout_ms = 0;
+            }
+            if (!source.next_timeout_ms) {
+                continue;
+            }
+            const uint32_t t = source.next_timeout_ms();
+            if (t != UINT32_MAX && (timeout_ms < 0 || t < static_cast<uint32_t>(timeout_ms))) {
+                timeout_ms = static_cast<int>(t);
+            }
+        }
+
+        // sources which were still pending before the wait (those readable again are dispatched only once)
+        std::vector<size_t> &pending = this->pending_indices;
+        pending.clear();
+        for (size_t i = 0; i < this->sources.size(); ++i) {
+            if (this->sources[i].pending) {
+                pending.push_back(i);
+            }
+        }
+
+        epoll_event events[16];
+        const int n = ::epoll_wait(this->epoll_fd, events, 16, timeout_ms);
+        int num_readable = 0;
+        for (int i = 0; i < n; ++i) {
+            if (events[i].data.u64 == UINT64_MAX) {
+                uint64_t value;
+                while (::read(this->wakeup_fd, &value, sizeof(value)) > 0) {
+                }
+                continue;
+            }
+            const size_t index = events[i].data.u64;
+            if (this->sources[index].paused) {
+                continue;
+            }
+            this->sources[index].pending = false;
+            this->dispatch(index);
+            ++num_readable;
+        }
+        for (const size_t index : pending) {
+            bool dispatched = false;
+            for (int i = 0; i < n; ++i) {
+                dispatched |= events[i].data.u64 == index;
+            }
+            if (!dispatched) {
+                this->dispatch(index);
+                ++num_readable;
+            }
+        }
+
+        for (const auto &source : this->sources) {
+            if (source.next_timeout_ms && source.on_timeout && source.next_timeout_ms() == 0) {
+                source.on_timeout();
+            }
+        }
+        return num_readable;
+    }
+
+    // run until stop() is called
+    void run()
+    {
+        while (!this->stopped) {
+            this->runOnce();
+        }
+        this->stopped = false;
+    }
+
+    // stop run() (thread-safe)
+    void stop()
+    {
+        this->stopped = true;
+        const uint64_t one = 1;
+        (void)!::write(this->wakeup_fd, &one, sizeof(one));
+    }
+
+private:
+    bool addSource(int fd, const std::function<Drain()> &on_readable, const std::function<uint32_t()> &next_timeout_ms, const std::function<void()> &on_timeout)
+    {
+        if (fd < 0 || this->epoll_fd < 0) {
+            return false;
+        }
+        if (!this->watch(fd, this->sources.size())) {
+            return false;
+        }
+        this->sources.push_back(Source {fd, on_readable, next_timeout_ms, on_timeout, false, false, 0});
+        return true;
+    }
+
+    bool watch(int fd, size_t index)
+    {
+        epoll_event ev {};
+        ev.events = EPOLLIN;
+        ev.data.u64 = index;
+        return ::epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, fd, &ev) == 0;
+    }
+
+    void dispatch(size_t index)
+    {
+        // on_readable may add sources, so do not hold the reference across the call
+        const Drain result = this->sources[index].on_readable();
+        Source &source = this->sources[index];
+        source.pending = result == Drain::More;
+        if (result == Drain::NotReady && !source.paused) {
+            // level-triggered EPOLLIN keeps firing while the datagram is unread, so stop watching for a while
+            ::epoll_ctl(this->epoll_fd, EPOLL_CTL_DEL, source.fd, nullptr);
+            source.paused = true;
+            source.paused_at_ms = this->millis();
+        }
+    }
+
+    void resume(size_t index)
+    {
+        Source &source = this->sources[index];
+        source.paused = false;
+        // try to read immediately in case the datagram arrived while paused
+        source.pending = true;
+        this->watch(source.fd, index);
+    }
+
+    uint32_t millis() const
+    {
+        using namespace std::chrono;
+        return static_cast<uint32_t>(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+};
+
+} // namespace host
+} // namespace art_net
+
+#endif // ARTNET_HOST_EVENT_LOOP_H
@@ -0,0 +1,455 @@
+#pragma once
+#ifndef ARTNET_HOST_LOOPBACK_UDP_H
+#define ARTNET_HOST_LOOPBACK_UDP_H
+
+#include "ArduinoShim.h"
+#include <deque>
+#include <mutex>
+#include <random>
+#include <vector>
+
+// In-memory UDP streams which connect Sender / Receiver / Manager in one process without network
+// Loss, reordering, delay and queue overflow can be injected to reproduce stress conditions.
+namespace art_net {
+namespace host {
+
+// Impairments applied to every datagram (per destination)
+struct LoopbackConditions
+{
+    size_t queue_depth {1024};       // max datagrams waiting per endpoint (extra ones are dropped)
+    float loss {0.f};                // probability to drop a datagram [0, 1]
+    float reorder {0.f};             // probability to deliver a datagram after the next one to the same endpoint [0, 1]
+    uint32_t reorder_timeout_us {10000};  // deliver the held datagram anyway if nothing follows within this time
+    uint32_t delay_us {0};           // fixed latency
+    uint32_t jitter_us {0};          // random extra latency in [0, jitter_us] (may also reorder datagrams)
+};
+
+struct LoopbackStats
+{
+    uint64_t sent {0};         // datagrams sent by endPacket()
+    uint64_t delivered {0};    // datagrams returned by parsePacket()
+    uint64_t lost {0};         // dropped by LoopbackConditions::loss
+    uint64_t overflowed {0};   // dropped because the queue of the destination was full
+    uint64_t reordered {0};    // delivered after the next datagram by LoopbackConditions::reorder
+    uint64_t unreachable {0};  // no endpoint for the destination address and port
+};
+
+// Switch which connects LoopbackUDP endpoints
+// - endpoints have addresses in 10.0.0.0/8 (assigned in the order of construction from 10.0.0.1)
+// - 255.255.255.255 and 10.255.255.255 are delivered to all endpoints on the port except the sender
+// - all impairments are decided by a seeded PRNG, so runs are reproducible with the same seed and the same order of sends
+// - thread-safe: senders and receivers can run on different threads
+class LoopbackNetwork
+{
+public:
+    struct Datagram
+    {
+        std::vector<uint8_t> data;
+        IPAddress ip;
+        uint16_t port {0};
+        uint64_t deliver_at_us {0};
+    };
+
+    struct Endpoint
+    {
+        IPAddress ip;
+        uint16_t port {0};
+        bool open {false};
+        std::deque<Datagram> queue;  // sorted by deliver_at_us
+        Datagram held;               // datagram waiting to be reordered
+        bool has_held {false};
+        uint64_t held_at_us {0};
+    };
+
+private:
+    mutable std::mutex mtx;
+    std::vector<Endpoint *> endpoints;
+    LoopbackConditions conds;
+    LoopbackStats net_stats;
+    std::mt19937 rng {1};
+    uint32_t num_hosts {0};
+    uint16_t next_ephemeral_port {49152};
+
+    // 64-bit time which does not wrap around (micros() wraps after about 71 minutes)
+    bool virtual_time {false};
+    uint64_t now_us {0};
+    uint32_t last_micros {0};
+
+public:
+    static IPAddress broadcastIP() { return IPAddress(10, 255, 255, 255); }
+    static IPAddress subnetMask() { return IPAddress(255, 0, 0, 0); }
+
+    void setConditions(const LoopbackConditions &c)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->conds = c;
+    }
+    LoopbackConditions conditions() const
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        return this->conds;
+    }
+
+    void seed(uint32_t s)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->rng.seed(s);
+    }
+
+    LoopbackStats stats() const
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        return this->net_stats;
+    }
+    void resetStats()
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->net_stats = LoopbackStats();
+    }
+
+    // With virtual time, delays only elapse by advanceUs() (e.g. to run faster than real time)
+    void useVirtualTime(bool enable)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->virtual_time = enable;
+        this->last_micros = micros();
+    }
+    void advanceUs(uint64_t us)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->now_us += us;
+    }
+    uint64_t nowUs()
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        return this->updateNow();
+    }
+
+    // [0, max) from the same seeded PRNG as the impairments (see Clock<LoopbackUDP>)
+    long random(long max)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        return max > 0 ? static_cast<long>(this->rng() % static_cast<uint32_t>(max)) : 0;
+    }
+
+    // number of datagrams waiting in all endpoints
+    size_t pending() const
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        size_t n = 0;
+        for (const Endpoint *ep : this->endpoints) {
+            n += ep->queue.size() + (ep->has_held ? 1 : 0);
+        }
+        return n;
+    }
+
+    // used by LoopbackUDP
+
+    IPAddress assignIP()
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        const uint32_t n = ++this->num_hosts;
+        return IPAddress(10, static_cast<uint8_t>(n >> 16), static_cast<uint8_t>(n >> 8), static_cast<uint8_t>(n));
+    }
+
+    void open(Endpoint &ep, uint16_t port)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        ep.port = port ? port : this->next_ephemeral_port++;
+        ep.open = true;
+        this->endpoints.push_back(&ep);
+    }
+
+    void close(Endpoint &ep)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        for (auto it = this->endpoints.begin(); it != this->endpoints.end(); ++it) {
+            if (*it == &ep) {
+                this->endpoints.erase(it);
+                break;
+            }
+        }
+        ep.open = false;
+        ep.queue.clear();
+        ep.has_held = false;
+    }
+
+    void send(const Endpoint &src, const IPAddress &ip, uint16_t port, const uint8_t *data, size_t size)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        ++this->net_stats.sent;
+        const uint64_t now = this->updateNow();
+        const bool broadcast = ip == IPAddress(255, 255, 255, 255) || ip == broadcastIP();
+        bool reached = false;
+        for (Endpoint *ep : this->endpoints) {
+            if (ep == &src || ep->port != port || (!broadcast && ep->ip != ip)) {
+                continue;
+            }
+            reached = true;
+            this->deliver(*ep, Datagram {std::vector<uint8_t>(data, data + size), src.ip, src.port, now}, now);
+        }
+        if (!reached) {
+            ++this->net_stats.unreachable;
+        }
+    }
+
+    bool receive(Endpoint &ep, Datagram &out)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        const uint64_t now = this->updateNow();
+        if (!ep.queue.empty() && ep.queue.front().deliver_at_us <= now) {
+            out = std::move(ep.queue.front());
+            ep.queue.pop_front();
+            ++this->net_stats.delivered;
+            return true;
+        }
+        // nothing followed the held datagram: deliver it without reordering
+        if (ep.has_held && ep.queue.empty() && now - ep.held_at_us >= this->conds.reorder_timeout_us && ep.held.deliver_at_us <= now) {
+            out = std::move(ep.held);
+            ep.has_held = false;
+            ++this->net_stats.delivered;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    uint64_t updateNow()
+    {
+        if (!this->virtual_time) {
+            const uint32_t t = micros();
+            this->now_us += static_cast<uint32_t>(t - this->last_micros);
+            this->last_micros = t;
+        }
+        return this->now_us;
+    }
+
+    // uniform in [0, 1) from the upper 24 bits (same sequence on every platform, unlike std::uniform_real_distribution)
+    float roll()
+    {
+        return static_cast<float>(this->rng() >> 8) * (1.f / 16777216.f);
+    }
+
+    void deliver(Endpoint &ep, Datagram &&d, uint64_t now)
+    {
+        if (this->conds.loss > 0.f && this->roll() < this->conds.loss) {
+            ++this->net_stats.lost;
+            return;
+        }
+        d.deliver_at_us = now + this->conds.delay_us;
+        if (this->conds.jitter_us > 0) {
+            d.deliver_at_us += this->rng() % (this->conds.jitter_us + 1);
+        }
+        if (ep.queue.size() + (ep.has_held ? 1 : 0) >= this->conds.queue_depth) {
+            ++this->net_stats.overflowed;
+            return;
+        }
+        if (!ep.has_held && this->conds.reorder > 0.f && this->roll() < this->conds.reorder) {
+            ep.held = std::move(d);
+            ep.has_held = true;
+            ep.held_at_us = now;
+            return;
+        }
+        const uint64_t deliver_at_us = d.deliver_at_us;
+        this->enqueue(ep, std::move(d));
+        if (ep.has_held) {
+            // swap with the datagram just queued
+            if (ep.held.deliver_at_us < deliver_at_us) {
+                ep.held.deliver_at_us = deliver_at_us;
+            }
+            this->enqueue(ep, std::move(ep.held));
+            ep.has_held = false;
+            ++this->net_stats.reordered;
+        }
+    }
+
+    static void enqueue(Endpoint &ep, Datagram &&d)
+    {
+        // after the datagrams with the same time to keep the order of sends
+        auto it = ep.queue.end();
+        while (it != ep.queue.begin() && (it - 1)->deliver_at_us > d.deliver_at_us) {
+            --it;
+        }
+        ep.queue.insert(it, std::move(d));
+    }
+};
+
+inline LoopbackNetwork &loopbackNetwork()
+{
+    static LoopbackNetwork network;
+    return network;
+}
+
+} // namespace host
+} // namespace art_net
+
+// UDP stream with the same interface as Arduino's UDP classes on LoopbackNetwork
+// The address is assigned by the network on construction and can be changed by setLocalIP() before begin().
+class LoopbackUDP
+{
+    art_net::host::LoopbackNetwork *network;
+    art_net::host::LoopbackNetwork::Endpoint endpoint;
+
+    art_net::host::LoopbackNetwork::Datagram rx;
+    size_t rx_pos {0};
+
+    std::vector<uint8_t> tx;
+    IPAddress tx_ip;
+    uint16_t tx_port {0};
+    bool tx_ready {false};
+
+public:
+    explicit LoopbackUDP(art_net::host::LoopbackNetwork &network = art_net::host::loopbackNetwork())
+    : network(&network)
+    {
+        this->endpoint.ip = network.assignIP();
+    }
+    LoopbackUDP(const LoopbackUDP &) = delete;
+    LoopbackUDP &operator=(const LoopbackUDP &) = delete;
+    ~LoopbackUDP()
+    {
+        this->stop();
+    }
+
+    void setLocalIP(const IPAddress &ip)
+    {
+        this->endpoint.ip = ip;
+    }
+    IPAddress localIP() const
+    {
+        return this->endpoint.ip;
+    }
+    // bound port (ephemeral port if begin(0))
+    uint16_t localPort() const
+    {
+        return this->endpoint.port;
+    }
+
+    // always returns 1 (port 0 assigns an ephemeral port)
+    uint8_t begin(uint16_t port)
+    {
+        this->stop();
+        this->network->open(this->endpoint, port);
+        return 1;
+    }
+
+    void stop()
+    {
+        if (this->endpoint.open) {
+            this->network->close(this->endpoint);
+        }
+        this->rx.data.clear();
+        this->rx_pos = 0;
+        this->tx_ready = false;
+    }
+
+    // receive
+
+    int parsePacket()
+    {
+        this->rx_pos = 0;
+        if (!this->endpoint.open || !this->network->receive(this->endpoint, this->rx)) {
+            this->rx.data.clear();
+            return 0;
+        }
+        return static_cast<int>(this->rx.data.size());
+    }
+
+    int available() const
+    {
+        return static_cast<int>(this->rx.data.size() - this->rx_pos);
+    }
+
+    int read()
+    {
+        if (this->rx_pos >= this->rx.data.size()) {
+            return -1;
+        }
+        return this->rx.data[this->rx_pos++];
+    }
+
+    int read(uint8_t *buffer, size_t len)
+    {
+        const size_t rest = this->rx.data.size() - this->rx_pos;
+        const size_t n = len < rest ? len : rest;
+        memcpy(buffer, this->rx.data.data() + this->rx_pos, n);
+        this->rx_pos += n;
+        return static_cast<int>(n);
+    }
+
+    int read(char *buffer, size_t len)
+    {
+        return this->read(reinterpret_cast<uint8_t *>(buffer), len);
+    }
+
+    int peek() const
+    {
+        return this->rx_pos < this->rx.data.size() ? this->rx.data[this->rx_pos] : -1;
+    }
+
+    void flush()
+    {
+        this->rx_pos = this->rx.data.size();
+    }
+
+    IPAddress remoteIP() const
+    {
+        return this->rx.ip;
+    }
+
+    uint16_t remotePort() const
+    {
+        return this->rx.port;
+    }
+
+    // send
+
+    int beginPacket(IPAddress ip, uint16_t port)
+    {
+        this->tx.clear();
+        this->tx_ip = ip;
+        this->tx_port = port;
+        this->tx_ready = true;
+        return 1;
+    }
+
+    int beginPacket(const char *host, uint16_t port)
+    {
+        IPAddress ip;
+        if (!ip.fromString(host)) {
+            this->tx_ready = false;
+            return 0;
+        }
+        return this->beginPacket(ip, port);
+    }
+
+    size_t write(uint8_t byte)
+    {
+        return this->write(&byte, 1);
+    }
+
+    size_t write(const uint8_t *buffer, size_t size)
+    {
+        if (!this->tx_ready) {
+            return 0;
+        }
+        // resize + memcpy instead of insert(), which GCC 12 falsely warns as an overflow (-Wstringop-overflow) when inlined
+        const size_t offset = this->tx.size();
+        this->tx.resize(offset + size);
+        memcpy(this->tx.data() + offset, buffer, size);
+        return size;
+    }
+
+    // returns 1 if the packet was passed to the network (even if it is lost or unreachable, same as UDP)
+    int endPacket()
+    {
+        if (!this->tx_ready || !this->endpoint.open) {
+            return 0;
+        }
+        this->tx_ready = false;
+        this->network->send(this->endpoint, this->tx_ip, this->tx_port, this->tx.data(), this->tx.size());
+        return 1;
+    }
+};
+
+#endif // ARTNET_HOST_LOOPBACK_UDP_H
@@ -0,0 +1,339 @@
+#pragma once
+#ifndef ARTNET_HOST_PCAP_H
+#define ARTNET_HOST_PCAP_H
+
+#include "ArduinoShim.h"
+#include <cstdio>
+#include <vector>
+
+// Minimal reader / writer of the classic pcap format (not pcapng) for UDP datagrams over IPv4
+// Link types: Ethernet (with 802.1Q VLAN tags), raw IPv4, BSD loopback, Linux cooked capture (SLL / SLL2)
+// NOTE: IP fragments are skipped (Art-Net packets fit into one Ethernet frame)
+namespace art_net {
+namespace host {
+
+namespace pcap {
+
+constexpr uint32_t MAGIC_US {0xA1B2C3D4};
+constexpr uint32_t MAGIC_NS {0xA1B23C4D};
+
+constexpr uint32_t LINKTYPE_NULL {0};
+constexpr uint32_t LINKTYPE_ETHERNET {1};
+constexpr uint32_t LINKTYPE_RAW_OLD {12};
+constexpr uint32_t LINKTYPE_RAW {101};
+constexpr uint32_t LINKTYPE_LINUX_SLL {113};
+constexpr uint32_t LINKTYPE_LINUX_SLL2 {276};
+
+constexpr size_t GLOBAL_HEADER_SIZE {24};
+constexpr size_t RECORD_HEADER_SIZE {16};
+constexpr uint32_t MAX_SNAPLEN {262144};
+
+inline uint16_t be16(const uint8_t *p)
+{
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+inline uint32_t swap32(uint32_t v)
+{
+    return ((v & 0xFF) << 24) | ((v & 0xFF00) << 8) | ((v >> 8) & 0xFF00) | (v >> 24);
+}
+
+} // namespace pcap
+
+// UDP datagram in the capture (payload points into the buffer of PcapReader, valid until the next call)
+struct PcapDatagram
+{
+    uint64_t timestamp_us;
+    IPAddress src_ip;
+    uint16_t src_port;
+    IPAddress dst_ip;
+    uint16_t dst_port;
+    const uint8_t *payload;
+    size_t size;
+};
+
+class PcapReader
+{
+    FILE *fp {nullptr};
+    bool swapped {false};
+    bool nanosec {false};
+    uint32_t link_type {0};
+    std::vector<uint8_t> frame;
+
+public:
+    PcapReader() = default;
+    PcapReader(const PcapReader &) = delete;
+    PcapReader &operator=(const PcapReader &) = delete;
+    ~PcapReader()
+    {
+        this->close();
+    }
+
+    // returns false if the file cannot be opened or is not a supported pcap file
+    bool open(const char *path)
+    {
+        this->close();
+        this->fp = std::fopen(path, "rb");
+        if (!this->fp) {
+            return false;
+        }
+        if (!this->readGlobalHeader()) {
+            this->close();
+            return false;
+        }
+        return true;
+    }
+
+    void close()
+    {
+        if (this->fp) {
+            std::fclose(this->fp);
+            this->fp = nullptr;
+        }
+    }
+
+    bool isOpen() const
+    {
+        return this->fp != nullptr;
+    }
+
+    uint32_t linkType() const
+    {
+        return this->link_type;
+    }
+
+    // back to the first record
+    void rewind()
+    {
+        if (this->fp) {
+            std::fseek(this->fp, pcap::GLOBAL_HEADER_SIZE, SEEK_SET);
+        }
+    }
+
+    /// @brief Read records until the next UDP datagram over IPv4
+    /// @return false at the end of the file (or if the file is truncated)
+    bool next(PcapDatagram &datagram)
+    {
+        if (!this->fp) {
+            return false;
+        }
+        uint8_t header[pcap::RECORD_HEADER_SIZE];
+        while (std::fread(header, 1, sizeof(header), this->fp) == sizeof(header)) {
+            const uint32_t sec = this->u32(header);
+            const uint32_t frac = this->u32(header + 4);
+            const uint32_t captured = this->u32(header + 8);
+            if (captured > pcap::MAX_SNAPLEN) {
+                return false;
+            }
+            this->frame.resize(captured);
+            if (captured && std::fread(this->frame.data(), 1, captured, this->fp) != captured) {
+                return false;
+            }
+            datagram.timestamp_us = static_cast<uint64_t>(sec) * 1000000 + (this->nanosec ? frac / 1000 : frac);
+            if (this->parseFrame(datagram)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    uint32_t u32(const uint8_t *p) const
+    {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        return this->swapped ? pcap::swap32(v) : v;
+    }
+
+    bool readGlobalHeader()
+    {
+        uint8_t header[pcap::GLOBAL_HEADER_SIZE];
+        if (std::fread(header, 1, sizeof(header), this->fp) != sizeof(header)) {
+            return false;
+        }
+        uint32_t magic;
+        memcpy(&magic, header, 4);
+        if (magic == pcap::MAGIC_US || magic == pcap::MAGIC_NS) {
+            this->swapped = false;
+        } else if (pcap::swap32(magic) == pcap::MAGIC_US || pcap::swap32(magic) == pcap::MAGIC_NS) {
+            this->swapped = true;
+            magic = pcap::swap32(magic);
+        } else {
+            return false;
+        }
+        this->nanosec = magic == pcap::MAGIC_NS;
+        this->link_type = this->u32(header + 20) & 0x0FFFFFFF;  // upper bits are FCS info
+        switch (this->link_type) {
+            case pcap::LINKTYPE_NULL:
+            case pcap::LINKTYPE_ETHERNET:
+            case pcap::LINKTYPE_RAW_OLD:
+            case pcap::LINKTYPE_RAW:
+            case pcap::LINKTYPE_LINUX_SLL:
+            case pcap::LINKTYPE_LINUX_SLL2:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // offset of the IPv4 header in the frame, or -1 if the frame is not IPv4
+    long ipv4Offset() const
+    {
+        const uint8_t *f = this->frame.data();
+        const size_t size = this->frame.size();
+        switch (this->link_type) {
+            case pcap::LINKTYPE_ETHERNET: {
+                size_t offset = 12;
+                while (offset + 2 <= size && (pcap::be16(f + offset) == 0x8100 || pcap::be16(f + offset) == 0x88A8)) {
+                    offset += 4;  // VLAN tag
+                }
+                return offset + 2 <= size && pcap::be16(f + offset) == 0x0800 ? static_cast<long>(offset + 2) : -1;
+            }
+            case pcap::LINKTYPE_RAW_OLD:
+            case pcap::LINKTYPE_RAW:
+                return 0;
+            case pcap::LINKTYPE_NULL:
+                // address family in the byte order of the capturing host (AF_INET is 2 on every OS)
+                return size >= 4 && (f[0] == 2 || f[3] == 2) ? 4 : -1;
+            case pcap::LINKTYPE_LINUX_SLL:
+                return size >= 16 && pcap::be16(f + 14) == 0x0800 ? 16 : -1;
+            case pcap::LINKTYPE_LINUX_SLL2:
+                return size >= 20 && pcap::be16(f) == 0x0800 ? 20 : -1;
+            default:
+                return -1;
+        }
+    }
+
+    bool parseFrame(PcapDatagram &datagram) const
+    {
+        const long ip_offset = this->ipv4Offset();
+        if (ip_offset < 0) {
+            return false;
+        }
+        const uint8_t *ip = this->frame.data() + ip_offset;
+        const size_t available = this->frame.size() - static_cast<size_t>(ip_offset);
+        if (available < 20 || (ip[0] >> 4) != 4 || ip[9] != 17) {
+            return false;  // not IPv4 / UDP
+        }
+        const size_t ihl = static_cast<size_t>(ip[0] & 0x0F) * 4;
+        const uint16_t fragment = pcap::be16(ip + 6);
+        if ((fragment & 0x2000) || (fragment & 0x1FFF)) {
+            return false;  // more fragments, or not the first fragment
+        }
+        if (ihl < 20 || available < ihl + 8) {
+            return false;
+        }
+        const uint8_t *udp = ip + ihl;
+        const size_t udp_length = pcap::be16(udp + 4);
+        if (udp_length < 8) {
+            return false;
+        }
+        datagram.src_ip = IPAddress(ip + 12);
+        datagram.dst_ip = IPAddress(ip + 16);
+        datagram.src_port = pcap::be16(udp);
+        datagram.dst_port = pcap::be16(udp + 2);
+        datagram.payload = udp + 8;
+        // truncated by the snap length of the capture
+        const size_t captured = available - ihl - 8;
+        datagram.size = udp_length - 8 < captured ? udp_length - 8 : captured;
+        return true;
+    }
+};
+
+// Writer of UDP datagrams as a classic pcap file (link type: raw IPv4, microsecond timestamps)
+// IPv4 / UDP headers are generated from the addresses (UDP checksum is not computed)
+class PcapWriter
+{
+    FILE *fp {nullptr};
+    uint16_t ip_id {0};
+
+public:
+    PcapWriter() = default;
+    PcapWriter(const PcapWriter &) = delete;
+    PcapWriter &operator=(const PcapWriter &) = delete;
+    ~PcapWriter()
+    {
+        this->close();
+    }
+
+    bool open(const char *path)
+    {
+        this->close();
+        this->fp = std::fopen(path, "wb");
+        if (!this->fp) {
+            return false;
+        }
+        const uint32_t header[6] {pcap::MAGIC_US, 0x00040002, 0, 0, 65535, pcap::LINKTYPE_RAW};  // version 2.4
+        if (std::fwrite(header, 1, sizeof(header), this->fp) != sizeof(header)) {
+            this->close();
+            return false;
+        }
+        return true;
+    }
+
+    void close()
+    {
+        if (this->fp) {
+            std::fclose(this->fp);
+            this->fp = nullptr;
+        }
+    }
+
+    bool isOpen() const
+    {
+        return this->fp != nullptr;
+    }
+
+    void flush()
+    {
+        if (this->fp) {
+            std::fflush(this->fp);
+        }
+    }
+
+    bool write(uint64_t timestamp_us, const IPAddress &src_ip, uint16_t src_port, const IPAddress &dst_ip, uint16_t dst_port, const uint8_t *payload, size_t size)
+    {
+        if (!this->fp || size > 65535 - 28) {
+            return false;
+        }
+        const uint16_t ip_length = static_cast<uint16_t>(28 + size);
+        uint8_t headers[28] {
+            0x45, 0, static_cast<uint8_t>(ip_length >> 8), static_cast<uint8_t>(ip_length),
+            static_cast<uint8_t>(this->ip_id >> 8), static_cast<uint8_t>(this->ip_id), 0x40, 0,  // don't fragment
+            64, 17, 0, 0,  // TTL, UDP, checksum
+        };
+        ++this->ip_id;
+        memcpy(headers + 12, src_ip.raw_address(), 4);
+        memcpy(headers + 16, dst_ip.raw_address(), 4);
+        uint32_t sum = 0;
+        for (size_t i = 0; i < 20; i += 2) {
+            sum += pcap::be16(headers + i);
+        }
+        sum = (sum & 0xFFFF) + (sum >> 16);
+        sum = (sum & 0xFFFF) + (sum >> 16);
+        headers[10] = static_cast<uint8_t>(~sum >> 8);
+        headers[11] = static_cast<uint8_t>(~sum);
+        const uint16_t udp_length = static_cast<uint16_t>(8 + size);
+        const uint8_t udp[8] {
+            static_cast<uint8_t>(src_port >> 8), static_cast<uint8_t>(src_port),
+            static_cast<uint8_t>(dst_port >> 8), static_cast<uint8_t>(dst_port),
+            static_cast<uint8_t>(udp_length >> 8), static_cast<uint8_t>(udp_length), 0, 0,
+        };
+        memcpy(headers + 20, udp, sizeof(udp));
+
+        const uint32_t record[4] {
+            static_cast<uint32_t>(timestamp_us / 1000000),
+            static_cast<uint32_t>(timestamp_us % 1000000),
+            ip_length,
+            ip_length,
+        };
+        return std::fwrite(record, 1, sizeof(record), this->fp) == sizeof(record)
+            && std::fwrite(headers, 1, sizeof(headers), this->fp) == sizeof(headers)
+            && std::fwrite(payload, 1, size, this->fp) == size;
+    }
+};
+
+} // namespace host
+} // namespace art_net
+
+#endif // ARTNET_HOST_PCAP_H
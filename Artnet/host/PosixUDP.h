@@ -0,0 +1,422 @@
+#pragma once
+#ifndef ARTNET_HOST_POSIX_UDP_H
+#define ARTNET_HOST_POSIX_UDP_H
+
+#include "ArduinoShim.h"
+#include <atomic>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+
+// UDP stream with the same interface as Arduino's UDP classes (WiFiUDP, EthernetUDP, etc.) using non-blocking POSIX sockets
+namespace art_net {
+namespace host {
+
+struct SocketStats
+{
+    uint64_t rx_syscalls {0};  // receive calls which returned datagrams
+    uint64_t rx_empty {0};     // receive calls which returned nothing (EAGAIN)
+    uint64_t rx_errors {0};    // receive calls which failed with other errors (e.g. ECONNREFUSED, ENOMEM)
+    int rx_last_error {0};     // errno of the last failed receive call
+    uint64_t rx_datagrams {0};
+    uint64_t tx_syscalls {0};
+    uint64_t tx_datagrams {0};
+};
+
+// count a receive call which returned no datagram: EAGAIN / EWOULDBLOCK (and EINTR) only means nothing is available
+inline void countReceiveFailure(SocketStats &stats, int err)
+{
+    if (err == EAGAIN || err == EWOULDBLOCK || err == EINTR) {
+        ++stats.rx_empty;
+    } else {
+        ++stats.rx_errors;
+        stats.rx_last_error = err;
+    }
+}
+
+// large enough to absorb bursts of thousands of universes (capped by net.core.rmem_max)
+static constexpr int DEFAULT_RECEIVE_BUFFER_SIZE {4 * 1024 * 1024};
+
+// non-blocking UDP socket bound to INADDR_ANY:port, returns -1 on failure
+// with reuse_port, multiple sockets can bind the same port and the kernel distributes datagrams by source address
+inline int openUdpSocket(uint16_t port, bool reuse_port = false)
+{
+    const int sock = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (sock < 0) {
+        return -1;
+    }
+    const int enable = 1;
+    ::setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    ::setsockopt(sock, SOL_SOCKET, SO_BROADCAST, &enable, sizeof(enable));
+    ::setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &DEFAULT_RECEIVE_BUFFER_SIZE, sizeof(DEFAULT_RECEIVE_BUFFER_SIZE));
+#ifdef SO_REUSEPORT
+    if (reuse_port && ::setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0) {
+        ::close(sock);
+        return -1;
+    }
+#else
+    if (reuse_port) {
+        ::close(sock);
+        return -1;
+    }
+#endif
+
+    sockaddr_in addr {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (::bind(sock, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        ::close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+inline bool resolveIPv4(const char *host, IPAddress &ip)
+{
+    if (ip.fromString(host)) {
+        return true;
+    }
+    addrinfo hints {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo *result = nullptr;
+    if (::getaddrinfo(host, nullptr, &hints, &result) != 0 || !result) {
+        return false;
+    }
+    ip = IPAddress(static_cast<uint32_t>(reinterpret_cast<sockaddr_in *>(result->ai_addr)->sin_addr.s_addr));
+    ::freeaddrinfo(result);
+    return true;
+}
+
+inline sockaddr_in toSockAddr(const IPAddress &ip, uint16_t port)
+{
+    sockaddr_in addr {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = static_cast<uint32_t>(ip);
+    addr.sin_port = htons(port);
+    return addr;
+}
+
+} // namespace host
+} // namespace art_net
+
+class PosixUDP
+{
+public:
+    static constexpr size_t RX_BUFFER_SIZE {1500};  // Ethernet MTU
+    static constexpr size_t TX_BUFFER_SIZE {1500};
+
+private:
+    int sock {-1};
+    bool reuse_port {false};
+
+    uint8_t rx_buffer[RX_BUFFER_SIZE];
+    size_t rx_size {0};
+    size_t rx_pos {0};
+    sockaddr_in remote {};
+
+    uint8_t tx_buffer[TX_BUFFER_SIZE];
+    size_t tx_size {0};
+    sockaddr_in tx_dest {};
+    bool tx_ready {false};
+
+    art_net::host::SocketStats socket_stats;
+
+public:
+    PosixUDP() = default;
+    PosixUDP(const PosixUDP &) = delete;
+    PosixUDP &operator=(const PosixUDP &) = delete;
+    ~PosixUDP()
+    {
+        this->stop();
+    }
+
+    // returns 1 if successful, 0 if there are no sockets available to use
+    uint8_t begin(uint16_t port)
+    {
+        this->stop();
+        this->sock = art_net::host::openUdpSocket(port, this->reuse_port);
+        return this->sock >= 0 ? 1 : 0;
+    }
+
+    // enable SO_REUSEPORT (call before begin())
+    void setReusePort(bool enable)
+    {
+        this->reuse_port = enable;
+    }
+
+    // socket file descriptor (-1 if not opened)
+    int fd() const
+    {
+        return this->sock;
+    }
+
+    void stop()
+    {
+        if (this->sock >= 0) {
+            ::close(this->sock);
+            this->sock = -1;
+        }
+        this->rx_size = this->rx_pos = 0;
+        this->tx_size = 0;
+        this->tx_ready = false;
+    }
+
+    // receive
+
+    // returns the size of the next datagram (0 if nothing is available)
+    int parsePacket()
+    {
+        this->rx_size = this->rx_pos = 0;
+        if (this->sock < 0) {
+            return 0;
+        }
+        socklen_t len = sizeof(this->remote);
+        const ssize_t n = ::recvfrom(this->sock, this->rx_buffer, RX_BUFFER_SIZE, 0, reinterpret_cast<sockaddr *>(&this->remote), &len);
+        if (n < 0) {
+            art_net::host::countReceiveFailure(this->socket_stats, errno);
+            return 0;
+        }
+        ++this->socket_stats.rx_syscalls;
+        if (n == 0) {
+            // empty datagram
+            return 0;
+        }
+        ++this->socket_stats.rx_datagrams;
+        this->rx_size = static_cast<size_t>(n);
+        return static_cast<int>(n);
+    }
+
+    int available() const
+    {
+        return static_cast<int>(this->rx_size - this->rx_pos);
+    }
+
+    int read()
+    {
+        if (this->rx_pos >= this->rx_size) {
+            return -1;
+        }
+        return this->rx_buffer[this->rx_pos++];
+    }
+
+    int read(uint8_t *buffer, size_t len)
+    {
+        const size_t n = len < this->rx_size - this->rx_pos ? len : this->rx_size - this->rx_pos;
+        memcpy(buffer, this->rx_buffer + this->rx_pos, n);
+        this->rx_pos += n;
+        return static_cast<int>(n);
+    }
+
+    int read(char *buffer, size_t len)
+    {
+        return this->read(reinterpret_cast<uint8_t *>(buffer), len);
+    }
+
+    int peek() const
+    {
+        return this->rx_pos < this->rx_size ? this->rx_buffer[this->rx_pos] : -1;
+    }
+
+    // discard the rest of the current datagram
+    void flush()
+    {
+        this->rx_pos = this->rx_size;
+    }
+
+    IPAddress remoteIP() const
+    {
+        return IPAddress(static_cast<uint32_t>(this->remote.sin_addr.s_addr));
+    }
+
+    uint16_t remotePort() const
+    {
+        return ntohs(this->remote.sin_port);
+    }
+
+    // send
+
+    int beginPacket(IPAddress ip, uint16_t port)
+    {
+        this->tx_dest = art_net::host::toSockAddr(ip, port);
+        this->tx_size = 0;
+        this->tx_ready = true;
+        return 1;
+    }
+
+    int beginPacket(const char *host, uint16_t port)
+    {
+        IPAddress ip;
+        if (!art_net::host::resolveIPv4(host, ip)) {
+            this->tx_ready = false;
+            return 0;
+        }
+        return this->beginPacket(ip, port);
+    }
+
+    size_t write(uint8_t byte)
+    {
+        return this->write(&byte, 1);
+    }
+
+    size_t write(const uint8_t *buffer, size_t size)
+    {
+        if (!this->tx_ready) {
+            return 0;
+        }
+        const size_t n = size < TX_BUFFER_SIZE - this->tx_size ? size : TX_BUFFER_SIZE - this->tx_size;
+        memcpy(this->tx_buffer + this->tx_size, buffer, n);
+        this->tx_size += n;
+        return n;
+    }
+
+    // returns 1 if the packet was sent successfully, 0 if there was an error
+    int endPacket()
+    {
+        if (!this->tx_ready || this->sock < 0) {
+            return 0;
+        }
+        this->tx_ready = false;
+        const ssize_t n = ::sendto(this->sock, this->tx_buffer, this->tx_size, 0, reinterpret_cast<const sockaddr *>(&this->tx_dest), sizeof(this->tx_dest));
+        ++this->socket_stats.tx_syscalls;
+        if (n != static_cast<ssize_t>(this->tx_size)) {
+            return 0;
+        }
+        ++this->socket_stats.tx_datagrams;
+        return 1;
+    }
+
+    const art_net::host::SocketStats &stats() const
+    {
+        return this->socket_stats;
+    }
+};
+
+// Network interface information (like WiFi / Ethernet on Arduino)
+// If no interface name is set, the first IPv4 interface which is up and not loopback is used,
+// or the loopback interface if there is no other one (e.g. loopback-only containers)
+// NOTE: isReady() is called for every packet by Sender/Receiver, so the result is cached for READY_CHECK_INTERVAL_MS
+class PosixNetworkClass
+{
+    static constexpr uint32_t READY_CHECK_INTERVAL_MS {1000};
+
+    String interface_name;
+    mutable std::atomic<bool> ready {false};
+    mutable std::atomic<bool> ready_checked {false};
+    mutable std::atomic<uint32_t> ready_checked_at_ms {0};
+
+public:
+    void setInterface(const String &name)
+    {
+        this->interface_name = name;
+        this->ready_checked = false;
+    }
+
+    const String &getInterface() const
+    {
+        return this->interface_name;
+    }
+
+    IPAddress localIP() const
+    {
+        IPAddress ip;
+        this->findInterface(&ip, nullptr, nullptr);
+        return ip;
+    }
+
+    IPAddress subnetMask() const
+    {
+        IPAddress mask;
+        this->findInterface(nullptr, &mask, nullptr);
+        return mask;
+    }
+
+    void macAddress(uint8_t mac[6]) const
+    {
+        memset(mac, 0, 6);
+        char name[IFNAMSIZ] {0};
+        if (!this->findInterface(nullptr, nullptr, name)) {
+            return;
+        }
+#ifdef SIOCGIFHWADDR
+        const int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            return;
+        }
+        ifreq req {};
+        snprintf(req.ifr_name, IFNAMSIZ, "%s", name);
+        if (::ioctl(fd, SIOCGIFHWADDR, &req) == 0) {
+            memcpy(mac, req.ifr_hwaddr.sa_data, 6);
+        }
+        ::close(fd);
+#endif
+    }
+
+    bool isReady() const
+    {
+        const uint32_t now = millis();
+        if (!this->ready_checked || (uint32_t)(now - this->ready_checked_at_ms) >= READY_CHECK_INTERVAL_MS) {
+            this->ready = this->findInterface(nullptr, nullptr, nullptr);
+            this->ready_checked_at_ms = now;
+            this->ready_checked = true;
+        }
+        return this->ready;
+    }
+
+private:
+    bool findInterface(IPAddress *ip, IPAddress *mask, char *name) const
+    {
+        ifaddrs *addrs = nullptr;
+        if (::getifaddrs(&addrs) != 0) {
+            return false;
+        }
+        const ifaddrs *found = nullptr;
+        const ifaddrs *loopback = nullptr;
+        for (const ifaddrs *it = addrs; it; it = it->ifa_next) {
+            if (!it->ifa_addr || it->ifa_addr->sa_family != AF_INET || !(it->ifa_flags & IFF_UP)) {
+                continue;
+            }
+            if (this->interface_name.isEmpty()) {
+                if (it->ifa_flags & IFF_LOOPBACK) {
+                    if (!loopback) {
+                        loopback = it;
+                    }
+                    continue;
+                }
+            } else if (this->interface_name != it->ifa_name) {
+                continue;
+            }
+            found = it;
+            break;
+        }
+        if (!found) {
+            found = loopback;
+        }
+        if (found) {
+            const ifaddrs *it = found;
+            if (ip) {
+                *ip = IPAddress(static_cast<uint32_t>(reinterpret_cast<sockaddr_in *>(it->ifa_addr)->sin_addr.s_addr));
+            }
+            if (mask && it->ifa_netmask) {
+                *mask = IPAddress(static_cast<uint32_t>(reinterpret_cast<sockaddr_in *>(it->ifa_netmask)->sin_addr.s_addr));
+            }
+            if (name) {
+                strncpy(name, it->ifa_name, IFNAMSIZ - 1);
+            }
+        }
+        ::freeifaddrs(addrs);
+        return found != nullptr;
+    }
+};
+
+inline PosixNetworkClass PosixNetwork;
+
+#endif // ARTNET_HOST_POSIX_UDP_H
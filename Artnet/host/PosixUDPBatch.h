@@ -0,0 +1,281 @@
+#pragma once
+#ifndef ARTNET_HOST_POSIX_UDP_BATCH_H
+#define ARTNET_HOST_POSIX_UDP_BATCH_H
+
+#include "PosixUDP.h"
+#include <vector>
+
+// UDP stream which receives up to BATCH_SIZE datagrams in one recvmmsg() call
+// and sends the packets between beginBatch() and endBatch() in one sendmmsg() call (Linux only)
+// - parsePacket() returns the next datagram of the batch, and calls recvmmsg() only when the batch is consumed
+// - outside of beginBatch() / endBatch(), endPacket() sends the packet immediately (same as PosixUDP)
+class PosixUDPBatch
+{
+public:
+    static constexpr size_t BATCH_SIZE {64};
+    static constexpr size_t SLOT_SIZE {1500};  // Ethernet MTU
+
+private:
+    struct Slots
+    {
+        std::vector<uint8_t> buffers;
+        std::vector<sockaddr_in> addrs;
+        std::vector<iovec> iovecs;
+        std::vector<mmsghdr> msgs;
+
+        Slots() : buffers(BATCH_SIZE * SLOT_SIZE), addrs(BATCH_SIZE), iovecs(BATCH_SIZE), msgs(BATCH_SIZE)
+        {
+            for (size_t i = 0; i < BATCH_SIZE; ++i) {
+                this->iovecs[i].iov_base = this->buffer(i);
+                this->iovecs[i].iov_len = SLOT_SIZE;
+                this->msgs[i] = mmsghdr {};
+                this->msgs[i].msg_hdr.msg_name = &this->addrs[i];
+                this->msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+                this->msgs[i].msg_hdr.msg_iov = &this->iovecs[i];
+                this->msgs[i].msg_hdr.msg_iovlen = 1;
+            }
+        }
+
+        uint8_t *buffer(size_t i) { return this->buffers.data() + i * SLOT_SIZE; }
+    };
+
+    int sock {-1};
+    bool reuse_port {false};
+
+    Slots rx;
+    size_t rx_count {0};  // number of datagrams in the current batch
+    size_t rx_index {0};  // index of the current datagram in the batch
+    size_t rx_size {0};
+    size_t rx_pos {0};
+
+    Slots tx;
+    size_t tx_count {0};  // number of packets queued in the batch
+    size_t tx_size {0};   // size of the packet being written
+    bool tx_ready {false};
+    bool batching {false};
+
+    art_net::host::SocketStats socket_stats;
+
+public:
+    PosixUDPBatch() = default;
+    PosixUDPBatch(const PosixUDPBatch &) = delete;
+    PosixUDPBatch &operator=(const PosixUDPBatch &) = delete;
+    ~PosixUDPBatch()
+    {
+        this->stop();
+    }
+
+    // returns 1 if successful, 0 if there are no sockets available to use
+    uint8_t begin(uint16_t port)
+    {
+        this->stop();
+        this->sock = art_net::host::openUdpSocket(port, this->reuse_port);
+        return this->sock >= 0 ? 1 : 0;
+    }
+
+    // enable SO_REUSEPORT (call before begin())
+    void setReusePort(bool enable)
+    {
+        this->reuse_port = enable;
+    }
+
+    // socket file descriptor (-1 if not opened)
+    int fd() const
+    {
+        return this->sock;
+    }
+
+    void stop()
+    {
+        if (this->sock >= 0) {
+            this->endBatch();
+            ::close(this->sock);
+            this->sock = -1;
+        }
+        this->rx_count = this->rx_index = 0;
+        this->rx_size = this->rx_pos = 0;
+        this->tx_count = this->tx_size = 0;
+        this->tx_ready = false;
+        this->batching = false;
+    }
+
+    // receive
+
+    // returns the size of the next datagram (0 if nothing is available)
+    int parsePacket()
+    {
+        this->rx_size = this->rx_pos = 0;
+        if (this->sock < 0) {
+            return 0;
+        }
+        if (this->rx_index + 1 < this->rx_count) {
+            ++this->rx_index;
+        } else if (!this->receiveBatch()) {
+            return 0;
+        }
+        this->rx_size = this->rx.msgs[this->rx_index].msg_len;
+        return static_cast<int>(this->rx_size);
+    }
+
+    int available() const
+    {
+        return static_cast<int>(this->rx_size - this->rx_pos);
+    }
+
+    int read()
+    {
+        if (this->rx_pos >= this->rx_size) {
+            return -1;
+        }
+        return this->currentRxBuffer()[this->rx_pos++];
+    }
+
+    int read(uint8_t *buffer, size_t len)
+    {
+        const size_t n = len < this->rx_size - this->rx_pos ? len : this->rx_size - this->rx_pos;
+        memcpy(buffer, this->currentRxBuffer() + this->rx_pos, n);
+        this->rx_pos += n;
+        return static_cast<int>(n);
+    }
+
+    int read(char *buffer, size_t len)
+    {
+        return this->read(reinterpret_cast<uint8_t *>(buffer), len);
+    }
+
+    int peek() const
+    {
+        return this->rx_pos < this->rx_size ? this->currentRxBuffer()[this->rx_pos] : -1;
+    }
+
+    // discard the rest of the current datagram
+    void flush()
+    {
+        this->rx_pos = this->rx_size;
+    }
+
+    IPAddress remoteIP() const
+    {
+        return IPAddress(static_cast<uint32_t>(this->rx.addrs[this->rx_index].sin_addr.s_addr));
+    }
+
+    uint16_t remotePort() const
+    {
+        return ntohs(this->rx.addrs[this->rx_index].sin_port);
+    }
+
+    // send
+
+    int beginPacket(IPAddress ip, uint16_t port)
+    {
+        this->tx.addrs[this->tx_count] = art_net::host::toSockAddr(ip, port);
+        this->tx_size = 0;
+        this->tx_ready = true;
+        return 1;
+    }
+
+    int beginPacket(const char *host, uint16_t port)
+    {
+        IPAddress ip;
+        if (!art_net::host::resolveIPv4(host, ip)) {
+            this->tx_ready = false;
+            return 0;
+        }
+        return this->beginPacket(ip, port);
+    }
+
+    size_t write(uint8_t byte)
+    {
+        return this->write(&byte, 1);
+    }
+
+    size_t write(const uint8_t *buffer, size_t size)
+    {
+        if (!this->tx_ready) {
+            return 0;
+        }
+        const size_t n = size < SLOT_SIZE - this->tx_size ? size : SLOT_SIZE - this->tx_size;
+        memcpy(this->tx.buffer(this->tx_count) + this->tx_size, buffer, n);
+        this->tx_size += n;
+        return n;
+    }
+
+    // returns 1 if the packet was sent (or queued in the batch) successfully, 0 if there was an error
+    int endPacket()
+    {
+        if (!this->tx_ready || this->sock < 0) {
+            return 0;
+        }
+        this->tx_ready = false;
+        this->tx.iovecs[this->tx_count].iov_len = this->tx_size;
+        ++this->tx_count;
+        if (this->batching && this->tx_count < BATCH_SIZE) {
+            return 1;
+        }
+        const size_t queued = this->tx_count;
+        return this->sendBatch() == queued ? 1 : 0;
+    }
+
+    // queue the packets until endBatch()
+    void beginBatch()
+    {
+        this->batching = true;
+    }
+
+    // send the queued packets in one sendmmsg() call
+    void endBatch()
+    {
+        this->batching = false;
+        if (this->tx_count > 0) {
+            this->sendBatch();
+        }
+    }
+
+    const art_net::host::SocketStats &stats() const
+    {
+        return this->socket_stats;
+    }
+
+private:
+    const uint8_t *currentRxBuffer() const
+    {
+        return this->rx.buffers.data() + this->rx_index * SLOT_SIZE;
+    }
+
+    bool receiveBatch()
+    {
+        this->rx_count = this->rx_index = 0;
+        for (size_t i = 0; i < BATCH_SIZE; ++i) {
+            this->rx.msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        }
+        const int n = ::recvmmsg(this->sock, this->rx.msgs.data(), BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (n <= 0) {
+            art_net::host::countReceiveFailure(this->socket_stats, n < 0 ? errno : EAGAIN);
+            return false;
+        }
+        ++this->socket_stats.rx_syscalls;
+        this->socket_stats.rx_datagrams += static_cast<uint64_t>(n);
+        this->rx_count = static_cast<size_t>(n);
+        return true;
+    }
+
+    // returns the number of packets sent, the queue is cleared regardless of errors
+    size_t sendBatch()
+    {
+        size_t sent = 0;
+        while (sent < this->tx_count) {
+            const int n = ::sendmmsg(this->sock, this->tx.msgs.data() + sent, static_cast<unsigned int>(this->tx_count - sent), 0);
+            ++this->socket_stats.tx_syscalls;
+            if (n <= 0) {
+                // EAGAIN (send buffer is full) or other errors: drop the rest same as PosixUDP
+                break;
+            }
+            sent += static_cast<size_t>(n);
+        }
+        this->socket_stats.tx_datagrams += sent;
+        this->tx_count = 0;
+        return sent;
+    }
+};
+
+#endif // ARTNET_HOST_POSIX_UDP_BATCH_H
@@ -0,0 +1,473 @@
+#pragma once
+#ifndef ARTNET_HOST_SHARDED_RECEIVER_H
+#define ARTNET_HOST_SHARDED_RECEIVER_H
+
+// This header is included from ArtnetLinux.h (needs the traits of PosixUDPBatch)
+
+#include "../PacketRing.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <pthread.h>
+
+namespace art_net {
+namespace host {
+
+// Multi-core receiver which partitions the dispatch by universe (Linux only)
+// - every worker thread has its own SO_REUSEPORT socket on the same port (the kernel distributes datagrams by source)
+// - ArtDmx / ArtNzs of a universe are always dispatched on the worker (universe % numWorkers()),
+//   so the callbacks for a universe run on the same thread in the order of arrival
+// - datagrams received by other workers are passed through SPSC rings (no lock, no allocation per packet)
+// - other packets (ArtPoll, ArtSync, ArtTrigger, ArtTimeCode) are handled by worker 0
+// - ArtPollReply lists the universes of all workers (MaxUniverses is the capacity of each worker, not of the total)
+// NOTE: callbacks can be subscribed after begin(), but set configs before begin()
+// NOTE: callbacks for different universes run concurrently on different threads.
+template <size_t MaxUniverses = DEFAULT_MAX_UNIVERSES, size_t RingSize = 128>
+class ShardedReceiver
+{
+    // subscriptions of workers are updated from the control thread while the workers dispatch
+    static_assert(ARTNET_THREAD_SAFE_SUBSCRIPTIONS, "ShardedReceiver needs ARTNET_THREAD_SAFE_SUBSCRIPTIONS");
+
+    // Receiver_ which dispatches datagrams received by the worker
+    struct Shard : Receiver_<PosixUDPBatch, MaxUniverses>
+    {
+        uint8_t packet_buffer[PACKET_SIZE];
+        ReceiverState<MaxUniverses> receiver_state;
+
+        Shard()
+        {
+            this->attachPacketBuffer(this->packet_buffer);
+            this->attachState(this->receiver_state);
+#if ARTNET_ENABLE_ART_POLL_REPLY
+            // ShardedReceiver replies with the universes of all shards
+            this->setArtPollReplyEnabled(false);
+#endif
+        }
+        void attachStream(PosixUDPBatch &stream)
+        {
+            this->attach(stream);
+        }
+#if ARTNET_ENABLE_ART_POLL_REPLY
+        // the scheduler of Receiver_ (only worker 0 receives ArtPoll)
+        using Receiver_<PosixUDPBatch, MaxUniverses>::scheduleArtPollReply;
+        using Receiver_<PosixUDPBatch, MaxUniverses>::forEachDuePollReply;
+#endif
+    };
+
+    struct Worker
+    {
+        PosixUDPBatch stream;
+        Shard shard;
+        std::thread thread;
+        std::atomic<uint64_t> received {0};   // datagrams received by the socket of this worker
+        std::atomic<uint64_t> forwarded {0};  // datagrams passed to other workers
+        std::atomic<uint64_t> dispatched {0}; // datagrams dispatched on this worker
+    };
+
+    using Ring = PacketRing<RingSize>;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::unique_ptr<Ring>> rings;  // rings[from * N + to]
+    std::atomic<bool> running {false};
+
+    enum PollReplyUniverseFlag : uint8_t
+    {
+        POLL_REPLY_DMX = 1 << 0,
+        POLL_REPLY_NZS = 1 << 1,
+    };
+
+#if ARTNET_ENABLE_ART_POLL_REPLY
+    // universe -> PollReplyUniverseFlag, and the config (updated by the control thread, read by worker 0)
+    mutable std::mutex poll_reply_mutex;
+    std::map<uint16_t, uint8_t> poll_reply_universes;
+    ArtPollReplyConfig poll_reply_config;
+#endif
+#if ARTNET_ENABLE_CAPTURE
+    std::atomic<ICaptureSink *> capture_sink {nullptr};
+#endif
+
+public:
+    struct WorkerStats
+    {
+        uint64_t received;
+        uint64_t forwarded;
+        uint64_t dispatched;
+        uint64_t ring_drops;  // datagrams dropped because the rings to this worker were full
+    };
+
+    explicit ShardedReceiver(size_t num_workers = std::thread::hardware_concurrency())
+    {
+        if (num_workers == 0) {
+            num_workers = 1;
+        }
+        for (size_t i = 0; i < num_workers; ++i) {
+            this->workers.emplace_back(new Worker());
+        }
+        for (size_t i = 0; i < num_workers * num_workers; ++i) {
+            // no ring from a worker to itself
+            this->rings.emplace_back(i % (num_workers + 1) == 0 ? nullptr : new Ring());
+        }
+    }
+
+    ~ShardedReceiver()
+    {
+        this->end();
+    }
+
+    size_t numWorkers() const
+    {
+        return this->workers.size();
+    }
+
+    size_t workerOf(uint16_t universe15bit) const
+    {
+        return universe15bit % this->workers.size();
+    }
+
+    /// @brief Open the sockets and start worker threads
+    /// @param pin_to_cores pin worker i to core (i % number of cores)
+    /// @return false if the sockets could not be opened (e.g. SO_REUSEPORT is not supported)
+    bool begin(uint16_t port = DEFAULT_PORT, bool pin_to_cores = true)
+    {
+        this->end();
+        for (auto &worker : this->workers) {
+            worker->stream.setReusePort(this->workers.size() > 1);
+            if (!worker->stream.begin(port)) {
+                for (auto &w : this->workers) {
+                    w->stream.stop();
+                }
+                return false;
+            }
+            worker->shard.attachStream(worker->stream);
+        }
+        this->running = true;
+        const size_t num_cores = std::thread::hardware_concurrency();
+        for (size_t i = 0; i < this->workers.size(); ++i) {
+            Worker &worker = *this->workers[i];
+            worker.thread = std::thread([this, i] {
+                this->run(i);
+            });
+            if (pin_to_cores && num_cores > 0) {
+                cpu_set_t cpus;
+                CPU_ZERO(&cpus);
+                CPU_SET(i % num_cores, &cpus);
+                pthread_setaffinity_np(worker.thread.native_handle(), sizeof(cpu_set_t), &cpus);
+            }
+        }
+        return true;
+    }
+
+    // stop worker threads and close the sockets
+    void end()
+    {
+        this->running = false;
+        for (auto &worker : this->workers) {
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+            worker->stream.stop();
+        }
+    }
+
+    WorkerStats stats(size_t index) const
+    {
+        const Worker &worker = *this->workers[index];
+        WorkerStats s {worker.received, worker.forwarded, worker.dispatched, 0};
+        for (size_t from = 0; from < this->workers.size(); ++from) {
+            if (const Ring *ring = this->ring(from, index)) {
+                s.ring_drops += ring->drops();
+            }
+        }
+        return s;
+    }
+
+#if ARTNET_ENABLE_ART_DMX
+    void subscribeArtDmxUniverse(uint8_t net, uint8_t subnet, uint8_t universe, const ArtDmxCallback &func)
+    {
+        uint16_t u = ((uint16_t)net << 8) | ((uint16_t)subnet << 4) | (uint16_t)universe;
+        this->subscribeArtDmxUniverse(u, func);
+    }
+    void subscribeArtDmxUniverse(uint16_t universe, const ArtDmxCallback &func)
+    {
+        this->shardOf(universe).subscribeArtDmxUniverse(universe, func);
+        this->registerPollReplyUniverse(universe, POLL_REPLY_DMX);
+    }
+    // called on every worker for the universes of the worker
+    void subscribeArtDmx(const ArtDmxCallback &func)
+    {
+        for (auto &worker : this->workers) {
+            worker->shard.subscribeArtDmx(func);
+        }
+    }
+    void unsubscribeArtDmxUniverse(uint16_t universe)
+    {
+        this->shardOf(universe).unsubscribeArtDmxUniverse(universe);
+        this->unregisterPollReplyUniverse(universe, POLL_REPLY_DMX);
+    }
+    void unsubscribeArtDmx()
+    {
+        for (auto &worker : this->workers) {
+            worker->shard.unsubscribeArtDmx();
+        }
+    }
+#endif
+
+#if ARTNET_ENABLE_ART_NZS
+    void subscribeArtNzsUniverse(uint16_t universe, const ArtNzsCallback &func)
+    {
+        this->shardOf(universe).subscribeArtNzsUniverse(universe, func);
+        this->registerPollReplyUniverse(universe, POLL_REPLY_NZS);
+    }
+    void unsubscribeArtNzsUniverse(uint16_t universe)
+    {
+        this->shardOf(universe).unsubscribeArtNzsUniverse(universe);
+        this->unregisterPollReplyUniverse(universe, POLL_REPLY_NZS);
+    }
+#endif
+
+#if ARTNET_ENABLE_ART_SYNC
+    void subscribeArtSync(const ArtSyncCallback &func)
+    {
+        this->workers[0]->shard.subscribeArtSync(func);
+    }
+#endif
+
+#if ARTNET_ENABLE_ART_TRIGGER
+    void subscribeArtTrigger(const ArtTriggerCallback &func)
+    {
+        this->workers[0]->shard.subscribeArtTrigger(func);
+    }
+#endif
+
+#if ARTNET_ENABLE_ART_TIMECODE
+    void subscribeArtTimeCode(const ArtTimeCodeCallback &func)
+    {
+        this->workers[0]->shard.subscribeArtTimeCode(func);
+    }
+#endif
+
+#if ARTNET_ENABLE_ART_POLL_REPLY
+    void setArtPollReplyConfig(const ArtPollReplyConfig &cfg)
+    {
+        std::lock_guard<std::mutex> lock(this->poll_reply_mutex);
+        this->poll_reply_config = cfg;
+    }
+#endif
+
+#if ARTNET_ENABLE_SOURCE_FILTER
+    void allowSource(const IPAddress &ip)
+    {
+        for (auto &worker : this->workers) {
+            worker->shard.allowSource(ip);
+        }
+    }
+    void denySource(const IPAddress &ip)
+    {
+        for (auto &worker : this->workers) {
+            worker->shard.denySource(ip);
+        }
+    }
+    void clearSourceFilters()
+    {
+        for (auto &worker : this->workers) {
+            worker->shard.clearSourceFilters();
+        }
+    }
+    // sum of all workers
+    SourceFilterDrops sourceFilterDrops() const
+    {
+        SourceFilterDrops drops {0, 0};
+        for (const auto &worker : this->workers) {
+            const SourceFilterDrops d = worker->shard.sourceFilterDrops();
+            drops.denied += d.denied;
+            drops.not_allowed += d.not_allowed;
+        }
+        return drops;
+    }
+#endif
+
+    void setLogger(Print *logger)
+    {
+        for (auto &worker : this->workers) {
+            worker->shard.setLogger(logger);
+        }
+    }
+
+#if ARTNET_ENABLE_CAPTURE
+    // all workers write into the same sink (CaptureRing drops instead of waiting if workers collide)
+    void setCaptureSink(ICaptureSink *sink)
+    {
+        for (auto &worker : this->workers) {
+            worker->shard.setCaptureSink(sink);
+        }
+        this->capture_sink = sink;
+    }
+#endif
+
+private:
+    Shard &shardOf(uint16_t universe)
+    {
+        return this->workers[this->workerOf(universe)]->shard;
+    }
+
+    Ring *ring(size_t from, size_t to) const
+    {
+        return this->rings[from * this->workers.size() + to].get();
+    }
+
+    // universes in ArtPollReply are kept apart from the subscriptions of the workers, so the total is not capped by MaxUniverses
+    void registerPollReplyUniverse(uint16_t universe, uint8_t flag)
+    {
+#if ARTNET_ENABLE_ART_POLL_REPLY
+        std::lock_guard<std::mutex> lock(this->poll_reply_mutex);
+        this->poll_reply_universes[universe] |= flag;
+#else
+        (void)universe;
+        (void)flag;
+#endif
+    }
+
+    void unregisterPollReplyUniverse(uint16_t universe, uint8_t flag)
+    {
+#if ARTNET_ENABLE_ART_POLL_REPLY
+        std::lock_guard<std::mutex> lock(this->poll_reply_mutex);
+        auto it = this->poll_reply_universes.find(universe);
+        if (it != this->poll_reply_universes.end()) {
+            it->second &= static_cast<uint8_t>(~flag);
+            if (it->second == 0) {
+                this->poll_reply_universes.erase(it);
+            }
+        }
+#else
+        (void)universe;
+        (void)flag;
+#endif
+    }
+
+#if ARTNET_ENABLE_ART_POLL_REPLY
+    // on worker 0 when the delay scheduled by shard 0 has elapsed
+    void sendArtPollReply(PosixUDPBatch &stream, const RemoteInfo &remote)
+    {
+        const IPAddress my_ip = getLocalIP<PosixUDPBatch>();
+        uint8_t my_mac[6];
+        getMacAddress<PosixUDPBatch>(my_mac);
+        // the packets differ only in the universe, and are sent while holding the lock (no copy of the registry)
+        std::lock_guard<std::mutex> lock(this->poll_reply_mutex);
+        art_poll_reply::Packet reply = art_poll_reply::generatePacketFrom(my_ip, my_mac, 0, this->poll_reply_config);
+        // if no universe is subscribed, send reply for universe 0
+        if (this->poll_reply_universes.empty()) {
+            this->sendArtPollReplyPacket(stream, remote, reply);
+            return;
+        }
+        for (const auto &u : this->poll_reply_universes) {
+            art_poll_reply::setUniverseTo(reply, u.first);
+            this->sendArtPollReplyPacket(stream, remote, reply);
+        }
+    }
+
+    void sendArtPollReplyPacket(PosixUDPBatch &stream, const RemoteInfo &remote, const art_poll_reply::Packet &reply)
+    {
+        stream.beginPacket(remote.ip, DEFAULT_PORT);
+        stream.write(reply.b, sizeof(art_poll_reply::Packet));
+        stream.endPacket();
+#if ARTNET_ENABLE_CAPTURE
+        if (ICaptureSink *sink = this->capture_sink) {
+            sink->capture(makeCaptureRecord(CaptureDirection::Sent, remote.ip, DEFAULT_PORT, Clock<PosixUDPBatch>::micros(), sizeof(art_poll_reply::Packet)), reply.b);
+        }
+#endif
+    }
+#endif
+
+    void dispatch(Worker &worker, const uint8_t *data, size_t size, const RemoteInfo &remote)
+    {
+        const OpCode op_code = worker.shard.parse(data, size, remote);
+        ++worker.dispatched;
+#if ARTNET_ENABLE_ART_POLL_REPLY
+        if (op_code == OpCode::Poll) {
+            worker.shard.scheduleArtPollReply(remote);
+        }
+#else
+        (void)op_code;
+#endif
+    }
+
+    // worker which dispatches the datagram
+    size_t ownerOf(const uint8_t *data, size_t size) const
+    {
+        if (size <= art_dmx::NET || strcmp(ARTNET_ID, reinterpret_cast<const char *>(data)) != 0) {
+            return 0;
+        }
+        const OpCode op_code = static_cast<OpCode>((data[art_dmx::OP_CODE_H] << 8) | data[art_dmx::OP_CODE_L]);
+        if (op_code != OpCode::Dmx && op_code != OpCode::Nzs) {
+            return 0;
+        }
+        return this->workerOf((data[art_dmx::NET] << 8) | data[art_dmx::SUBUNI]);
+    }
+
+    void run(size_t index)
+    {
+        Worker &worker = *this->workers[index];
+        const size_t num_workers = this->workers.size();
+        uint8_t buffer[PACKET_SIZE];
+
+        while (this->running) {
+            bool idle = true;
+
+            // datagrams from the socket of this worker
+            for (size_t n = 0; n < PosixUDPBatch::BATCH_SIZE; ++n) {
+                int size = worker.stream.parsePacket();
+                if (size <= 0) {
+                    break;
+                }
+                idle = false;
+                ++worker.received;
+                size = worker.stream.read(buffer, sizeof(buffer));
+                const RemoteInfo remote {worker.stream.remoteIP(), worker.stream.remotePort(), Clock<PosixUDPBatch>::micros()};
+                const size_t owner = this->ownerOf(buffer, static_cast<size_t>(size));
+                if (owner == index) {
+                    this->dispatch(worker, buffer, static_cast<size_t>(size), remote);
+                } else {
+                    this->ring(index, owner)->push(buffer, static_cast<size_t>(size), remote);
+                    ++worker.forwarded;
+                }
+            }
+
+            // datagrams passed from other workers
+            for (size_t from = 0; from < num_workers; ++from) {
+                Ring *ring = this->ring(from, index);
+                if (!ring) {
+                    continue;
+                }
+                while (const typename Ring::Slot *slot = ring->front()) {
+                    this->dispatch(worker, slot->data, slot->size, slot->remote);
+                    ring->pop();
+                    idle = false;
+                }
+            }
+
+            worker.shard.update();
+#if ARTNET_ENABLE_ART_POLL_REPLY
+            if (index == 0) {
+                worker.shard.forEachDuePollReply([&](const RemoteInfo &remote) {
+                    this->sendArtPollReply(worker.stream, remote);
+                });
+            }
+#endif
+
+            if (idle) {
+                // sleep until datagrams arrive (datagrams in the rings wait at most 1 ms)
+                pollfd pfd {worker.stream.fd(), POLLIN, 0};
+                ::poll(&pfd, 1, 1);
+            }
+        }
+    }
+};
+
+} // namespace host
+} // namespace art_net
+
+#endif // ARTNET_HOST_SHARDED_RECEIVER_H
@@ -0,0 +1,860 @@
+#pragma once
+#ifndef ARTNET_HOST_SHOW_H
+#define ARTNET_HOST_SHOW_H
+
+// This header is included from ArtnetLinux.h (needs Sender_ / Receiver_)
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+// Recording of ArtDmx / ArtSync into an append-only file, and timed playback through Sender_
+//
+// File format (all integers are little endian)
+// - header (16 bytes) : "ASHW", version (u16), header size (u16), key frame interval in ms (u32), reserved (u32)
+// - records           : type (u8), reserved (u8), universe (u16), size (u16), payload size (u16), delta time in us (u32), payload
+//   - Full     : DMX data of the universe (size bytes)
+//   - Delta    : changed bytes from the last frame of the universe, as runs of offset (u16), length (u16), bytes
+//   - Sync     : ArtSync (no payload)
+//   - KeyFrame : absolute time in us (u64), followed by State records (full data of every universe, not sent)
+//   - End      : end of the records
+// - index             : time (u64) and file offset (u64) of every KeyFrame, written by close()
+// - footer (24 bytes) : index offset (u64), number of index entries (u32), duration in us (u64), "ASHX"
+// Delta time is from the previous record, so it never exceeds the key frame interval.
+// If the recording was not closed (e.g. crashed), there is no index and the player finds the key frames by scanning the file.
+namespace art_net {
+namespace host {
+
+namespace show {
+
+constexpr uint8_t MAGIC[4] {'A', 'S', 'H', 'W'};
+constexpr uint8_t FOOTER_MAGIC[4] {'A', 'S', 'H', 'X'};
+constexpr uint16_t VERSION {1};
+constexpr size_t HEADER_SIZE {16};
+constexpr size_t RECORD_HEADER_SIZE {12};
+constexpr size_t INDEX_ENTRY_SIZE {16};
+constexpr size_t FOOTER_SIZE {24};
+constexpr size_t MAX_PAYLOAD_SIZE {512};
+constexpr uint32_t DEFAULT_KEY_FRAME_INTERVAL_MS {1000};
+constexpr uint32_t MAX_KEY_FRAME_INTERVAL_MS {3600000};  // delta time fits into u32
+
+enum class RecordType : uint8_t
+{
+    Full,
+    Delta,
+    Sync,
+    KeyFrame,
+    State,
+    End,
+};
+
+// a new run costs 4 bytes of header, so shorter gaps between changed bytes are included in the run
+constexpr size_t MIN_RUN_GAP {4};
+
+inline void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+inline void put32(uint8_t *p, uint32_t v)
+{
+    put16(p, static_cast<uint16_t>(v));
+    put16(p + 2, static_cast<uint16_t>(v >> 16));
+}
+
+inline void put64(uint8_t *p, uint64_t v)
+{
+    put32(p, static_cast<uint32_t>(v));
+    put32(p + 4, static_cast<uint32_t>(v >> 32));
+}
+
+inline uint16_t get16(const uint8_t *p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t get32(const uint8_t *p)
+{
+    return static_cast<uint32_t>(get16(p)) | (static_cast<uint32_t>(get16(p + 2)) << 16);
+}
+
+inline uint64_t get64(const uint8_t *p)
+{
+    return static_cast<uint64_t>(get32(p)) | (static_cast<uint64_t>(get32(p + 4)) << 32);
+}
+
+// last frame of a universe (delta base of the recorder, decoded frame of the reader)
+struct UniverseFrame
+{
+    uint16_t size {0};
+    uint8_t data[MAX_PAYLOAD_SIZE];
+};
+
+struct KeyFrameIndex
+{
+    uint64_t time_us;
+    uint64_t offset;
+};
+
+} // namespace show
+
+// Writes ArtDmx / ArtSync received by Receiver_ into a show file
+// Only the changed bytes of each universe are written, so the file grows by about 12 bytes per unchanged frame.
+// NOTE: records are written by stdio on the thread which calls the callbacks, call close() after receiving is stopped
+class ShowRecorder
+{
+    FILE *fp {nullptr};
+    uint64_t offset {0};
+    uint32_t key_frame_interval_us {0};
+    std::map<uint16_t, show::UniverseFrame> universes;
+    std::vector<show::KeyFrameIndex> index;
+
+    bool has_time {false};
+    uint32_t last_received_us {0};
+    uint64_t elapsed_us {0};
+    uint64_t last_time_us {0};
+    uint64_t last_key_frame_us {0};
+    uint32_t pending_delta_us {0};  // delta time of the next record
+    uint64_t num_records {0};
+    bool failed {false};
+
+public:
+    ShowRecorder() = default;
+    ShowRecorder(const ShowRecorder &) = delete;
+    ShowRecorder &operator=(const ShowRecorder &) = delete;
+    ~ShowRecorder()
+    {
+        this->close();
+    }
+
+    /// @brief Create the file (the recording starts at the first packet)
+    /// @param key_frame_interval_ms interval of the key frames (full data of all universes) for seeking
+    bool open(const char *path, uint32_t key_frame_interval_ms = show::DEFAULT_KEY_FRAME_INTERVAL_MS)
+    {
+        this->close();
+        if (key_frame_interval_ms == 0 || key_frame_interval_ms > show::MAX_KEY_FRAME_INTERVAL_MS) {
+            return false;
+        }
+        this->fp = std::fopen(path, "wb");
+        if (!this->fp) {
+            return false;
+        }
+        this->key_frame_interval_us = key_frame_interval_ms * 1000;
+        this->universes.clear();
+        this->index.clear();
+        this->has_time = false;
+        this->elapsed_us = 0;
+        this->last_time_us = 0;
+        this->num_records = 0;
+        this->failed = false;
+        this->offset = 0;
+
+        uint8_t header[show::HEADER_SIZE] {};
+        memcpy(header, show::MAGIC, sizeof(show::MAGIC));
+        show::put16(header + 4, show::VERSION);
+        show::put16(header + 6, show::HEADER_SIZE);
+        show::put32(header + 8, key_frame_interval_ms);
+        this->writeBytes(header, sizeof(header));
+        return !this->failed;
+    }
+
+    // write the index and close the file
+    void close()
+    {
+        if (!this->fp) {
+            return;
+        }
+        this->writeRecord(show::RecordType::End, 0, 0, nullptr, 0);
+        const uint64_t index_offset = this->offset;
+        for (const auto &entry : this->index) {
+            uint8_t buffer[show::INDEX_ENTRY_SIZE];
+            show::put64(buffer, entry.time_us);
+            show::put64(buffer + 8, entry.offset);
+            this->writeBytes(buffer, sizeof(buffer));
+        }
+        uint8_t footer[show::FOOTER_SIZE];
+        show::put64(footer, index_offset);
+        show::put32(footer + 8, static_cast<uint32_t>(this->index.size()));
+        show::put64(footer + 12, this->last_time_us);
+        memcpy(footer + 20, show::FOOTER_MAGIC, sizeof(show::FOOTER_MAGIC));
+        this->writeBytes(footer, sizeof(footer));
+        std::fclose(this->fp);
+        this->fp = nullptr;
+    }
+
+    bool isOpen() const
+    {
+        return this->fp != nullptr;
+    }
+
+    // true if any write to the file failed (e.g. disk full)
+    bool hasError() const
+    {
+        return this->failed;
+    }
+
+    void flush()
+    {
+        if (this->fp) {
+            std::fflush(this->fp);
+        }
+    }
+
+    // record ArtDmx (and ArtSync) received by the receiver (replaces the callbacks of subscribeArtDmx() / subscribeArtSync())
+    template <typename Receiver>
+    void subscribe(Receiver &receiver)
+    {
+        receiver.subscribeArtDmx([this](const uint8_t *data, uint16_t size, const ArtDmxMetadata &metadata, const ArtNetRemoteInfo &remote) {
+            const uint16_t universe = (metadata.net << 8) | (metadata.subnet << 4) | metadata.universe;
+            this->recordArtDmx(this->timeOf(remote.received_us), universe, data, size);
+        });
+#if ARTNET_ENABLE_ART_SYNC
+        receiver.subscribeArtSync([this](const ArtNetRemoteInfo &remote) {
+            this->recordArtSync(this->timeOf(remote.received_us));
+        });
+#endif
+    }
+
+    /// @brief Append a frame of the universe
+    /// @param time_us time from the start of the recording (should not go backwards)
+    void recordArtDmx(uint64_t time_us, uint16_t universe, const uint8_t *data, uint16_t size)
+    {
+        if (!this->fp) {
+            return;
+        }
+        if (size > show::MAX_PAYLOAD_SIZE) {
+            size = show::MAX_PAYLOAD_SIZE;
+        }
+        this->beginRecord(time_us);
+        auto it = this->universes.find(universe);
+        if (it == this->universes.end() || it->second.size != size) {
+            this->writeRecord(show::RecordType::Full, universe, size, data, size);
+            show::UniverseFrame &frame = this->universes[universe];
+            frame.size = size;
+            memcpy(frame.data, data, size);
+            return;
+        }
+        show::UniverseFrame &frame = it->second;
+        uint8_t payload[show::MAX_PAYLOAD_SIZE];
+        const size_t payload_size = this->encodeDelta(frame, data, payload);
+        if (payload_size < size) {
+            this->writeRecord(show::RecordType::Delta, universe, size, payload, payload_size);
+        } else {
+            this->writeRecord(show::RecordType::Full, universe, size, data, size);
+        }
+        memcpy(frame.data, data, size);
+    }
+
+    void recordArtSync(uint64_t time_us)
+    {
+        if (!this->fp) {
+            return;
+        }
+        this->beginRecord(time_us);
+        this->writeRecord(show::RecordType::Sync, 0, 0, nullptr, 0);
+    }
+
+    // number of records written (including key frames)
+    uint64_t records() const
+    {
+        return this->num_records;
+    }
+
+    uint64_t bytesWritten() const
+    {
+        return this->offset;
+    }
+
+    // time of the last record from the start of the recording
+    uint64_t durationUs() const
+    {
+        return this->last_time_us;
+    }
+
+private:
+    // received_us (wraps around) to the time from the first packet
+    uint64_t timeOf(uint32_t received_us)
+    {
+        if (!this->has_time) {
+            this->has_time = true;
+            this->last_received_us = received_us;
+        }
+        const int32_t diff = static_cast<int32_t>(received_us - this->last_received_us);
+        if (diff > 0) {
+            this->elapsed_us += static_cast<uint32_t>(diff);
+            this->last_received_us = received_us;
+        }
+        return this->elapsed_us;
+    }
+
+    void beginRecord(uint64_t time_us)
+    {
+        if (time_us < this->last_time_us) {
+            time_us = this->last_time_us;
+        }
+        if (this->num_records == 0 || time_us - this->last_key_frame_us >= this->key_frame_interval_us) {
+            this->writeKeyFrame(time_us);
+        }
+        this->pending_delta_us = static_cast<uint32_t>(time_us - this->last_time_us);
+        this->last_time_us = time_us;
+    }
+
+    void writeKeyFrame(uint64_t time_us)
+    {
+        this->index.push_back(show::KeyFrameIndex {time_us, this->offset});
+        uint8_t payload[8];
+        show::put64(payload, time_us);
+        this->pending_delta_us = 0;
+        this->writeRecord(show::RecordType::KeyFrame, 0, static_cast<uint16_t>(this->universes.size()), payload, sizeof(payload));
+        for (const auto &u : this->universes) {
+            this->writeRecord(show::RecordType::State, u.first, u.second.size, u.second.data, u.second.size);
+        }
+        this->last_key_frame_us = time_us;
+        this->last_time_us = time_us;
+    }
+
+    // runs of changed bytes, returns the payload size (or >= frame.size if it is not smaller than the full data)
+    size_t encodeDelta(const show::UniverseFrame &frame, const uint8_t *data, uint8_t *payload) const
+    {
+        size_t payload_size = 0;
+        size_t i = 0;
+        while (i < frame.size) {
+            if (frame.data[i] == data[i]) {
+                ++i;
+                continue;
+            }
+            const size_t begin = i;
+            size_t end = i + 1;
+            for (size_t j = end; j < frame.size && j < end + show::MIN_RUN_GAP; ++j) {
+                if (frame.data[j] != data[j]) {
+                    end = j + 1;
+                }
+            }
+            const size_t length = end - begin;
+            if (payload_size + 4 + length >= frame.size) {
+                return frame.size;
+            }
+            show::put16(payload + payload_size, static_cast<uint16_t>(begin));
+            show::put16(payload + payload_size + 2, static_cast<uint16_t>(length));
+            memcpy(payload + payload_size + 4, data + begin, length);
+            payload_size += 4 + length;
+            i = end;
+        }
+        return payload_size;
+    }
+
+    void writeRecord(show::RecordType type, uint16_t universe, uint16_t size, const uint8_t *payload, size_t payload_size)
+    {
+        uint8_t header[show::RECORD_HEADER_SIZE];
+        header[0] = static_cast<uint8_t>(type);
+        header[1] = 0;
+        show::put16(header + 2, universe);
+        show::put16(header + 4, size);
+        show::put16(header + 6, static_cast<uint16_t>(payload_size));
+        show::put32(header + 8, this->pending_delta_us);
+        this->pending_delta_us = 0;
+        this->writeBytes(header, sizeof(header));
+        if (payload_size) {
+            this->writeBytes(payload, payload_size);
+        }
+        ++this->num_records;
+    }
+
+    void writeBytes(const uint8_t *data, size_t size)
+    {
+        if (std::fwrite(data, 1, size, this->fp) != size) {
+            this->failed = true;
+        }
+        this->offset += size;
+    }
+};
+
+// Frame decoded by ShowReader (data points to the frame of the universe in the reader, valid until the next call)
+struct ShowFrame
+{
+    show::RecordType type;
+    uint64_t time_us;
+    uint16_t universe;
+    const uint8_t *data;
+    uint16_t size;
+};
+
+// Streams the records of a show file from the disk (only the last frame of each universe is kept in memory)
+class ShowReader
+{
+    FILE *fp {nullptr};
+    uint32_t key_frame_interval_ms {0};
+    uint64_t duration_us {0};
+    uint64_t time_us {0};
+    bool at_end {false};  // the index follows the End record
+    std::vector<show::KeyFrameIndex> index;
+    std::map<uint16_t, show::UniverseFrame> universes;
+    uint8_t payload[show::MAX_PAYLOAD_SIZE];
+
+public:
+    ShowReader() = default;
+    ShowReader(const ShowReader &) = delete;
+    ShowReader &operator=(const ShowReader &) = delete;
+    ~ShowReader()
+    {
+        this->close();
+    }
+
+    // returns false if the file cannot be opened or is not a show file
+    bool open(const char *path)
+    {
+        this->close();
+        this->fp = std::fopen(path, "rb");
+        if (!this->fp) {
+            return false;
+        }
+        uint8_t header[show::HEADER_SIZE];
+        if (std::fread(header, 1, sizeof(header), this->fp) != sizeof(header)
+            || memcmp(header, show::MAGIC, sizeof(show::MAGIC)) != 0
+            || show::get16(header + 4) != show::VERSION
+            || show::get16(header + 6) != show::HEADER_SIZE) {
+            this->close();
+            return false;
+        }
+        this->key_frame_interval_ms = show::get32(header + 8);
+        if (!this->readIndex()) {
+            this->scanIndex();
+        }
+        this->rewind();
+        return true;
+    }
+
+    void close()
+    {
+        if (this->fp) {
+            std::fclose(this->fp);
+            this->fp = nullptr;
+        }
+        this->index.clear();
+        this->universes.clear();
+        this->duration_us = 0;
+    }
+
+    bool isOpen() const
+    {
+        return this->fp != nullptr;
+    }
+
+    uint64_t durationUs() const
+    {
+        return this->duration_us;
+    }
+
+    uint32_t keyFrameIntervalMs() const
+    {
+        return this->key_frame_interval_ms;
+    }
+
+    size_t numKeyFrames() const
+    {
+        return this->index.size();
+    }
+
+    // back to the first record
+    void rewind()
+    {
+        if (this->fp) {
+            std::fseek(this->fp, show::HEADER_SIZE, SEEK_SET);
+        }
+        this->universes.clear();
+        this->time_us = 0;
+        this->at_end = false;
+    }
+
+    // move to the last key frame at or before time_us (returns the time of the key frame)
+    uint64_t seekKeyFrame(uint64_t time_us)
+    {
+        auto it = std::upper_bound(this->index.begin(), this->index.end(), time_us, [](uint64_t t, const show::KeyFrameIndex &entry) {
+            return t < entry.time_us;
+        });
+        if (it == this->index.begin()) {
+            this->rewind();
+            return 0;
+        }
+        --it;
+        std::fseek(this->fp, static_cast<long>(it->offset), SEEK_SET);
+        this->universes.clear();
+        this->time_us = it->time_us;
+        this->at_end = false;
+        return it->time_us;
+    }
+
+    /// @brief Read and decode the next record
+    /// @return false at the end of the records (or if the file is truncated / broken)
+    bool next(ShowFrame &frame)
+    {
+        if (!this->fp || this->at_end) {
+            return false;
+        }
+        if (!this->decode(frame)) {
+            this->at_end = true;
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Read the type and the time of the next record without decoding it
+    /// @return false at the end of the records
+    bool peek(show::RecordType &type, uint64_t &time_us)
+    {
+        if (!this->fp || this->at_end) {
+            return false;
+        }
+        uint8_t header[show::RECORD_HEADER_SIZE];
+        const long pos = std::ftell(this->fp);
+        const bool ok = std::fread(header, 1, sizeof(header), this->fp) == sizeof(header);
+        std::fseek(this->fp, pos, SEEK_SET);
+        if (!ok) {
+            return false;
+        }
+        type = static_cast<show::RecordType>(header[0]);
+        time_us = this->time_us + show::get32(header + 8);
+        return type != show::RecordType::End;
+    }
+
+    // call func(universe, data, size) for the current frame of every universe
+    template <typename Func>
+    void forEachUniverse(const Func &func) const
+    {
+        for (const auto &u : this->universes) {
+            func(u.first, u.second.data, u.second.size);
+        }
+    }
+
+private:
+    bool decode(ShowFrame &frame)
+    {
+        uint8_t header[show::RECORD_HEADER_SIZE];
+        if (std::fread(header, 1, sizeof(header), this->fp) != sizeof(header)) {
+            return false;
+        }
+        const show::RecordType type = static_cast<show::RecordType>(header[0]);
+        const uint16_t universe = show::get16(header + 2);
+        const uint16_t size = show::get16(header + 4);
+        const uint16_t payload_size = show::get16(header + 6);
+        if (type == show::RecordType::End || payload_size > sizeof(this->payload) || size > show::MAX_PAYLOAD_SIZE) {
+            return false;
+        }
+        if (payload_size && std::fread(this->payload, 1, payload_size, this->fp) != payload_size) {
+            return false;
+        }
+        this->time_us += show::get32(header + 8);
+
+        frame.type = type;
+        frame.universe = universe;
+        frame.data = nullptr;
+        frame.size = 0;
+        switch (type) {
+            case show::RecordType::KeyFrame: {
+                if (payload_size < 8) {
+                    return false;
+                }
+                this->time_us = show::get64(this->payload);
+                break;
+            }
+            case show::RecordType::Full:
+            case show::RecordType::State: {
+                if (payload_size != size) {
+                    return false;
+                }
+                show::UniverseFrame &u = this->universes[universe];
+                u.size = size;
+                memcpy(u.data, this->payload, size);
+                frame.data = u.data;
+                frame.size = size;
+                break;
+            }
+            case show::RecordType::Delta: {
+                auto it = this->universes.find(universe);
+                if (it == this->universes.end() || it->second.size != size || !this->applyDelta(it->second, payload_size)) {
+                    return false;
+                }
+                frame.type = show::RecordType::Full;  // decoded
+                frame.data = it->second.data;
+                frame.size = size;
+                break;
+            }
+            case show::RecordType::Sync: {
+                break;
+            }
+            default: {
+                return false;
+            }
+        }
+        frame.time_us = this->time_us;
+        return true;
+    }
+
+    bool applyDelta(show::UniverseFrame &frame, size_t payload_size)
+    {
+        size_t i = 0;
+        while (i + 4 <= payload_size) {
+            const uint16_t offset = show::get16(this->payload + i);
+            const uint16_t length = show::get16(this->payload + i + 2);
+            if (offset + length > frame.size || i + 4 + length > payload_size) {
+                return false;
+            }
+            memcpy(frame.data + offset, this->payload + i + 4, length);
+            i += 4 + length;
+        }
+        return i == payload_size;
+    }
+
+    bool readIndex()
+    {
+        uint8_t footer[show::FOOTER_SIZE];
+        if (std::fseek(this->fp, -static_cast<long>(show::FOOTER_SIZE), SEEK_END) != 0
+            || std::fread(footer, 1, sizeof(footer), this->fp) != sizeof(footer)
+            || memcmp(footer + 20, show::FOOTER_MAGIC, sizeof(show::FOOTER_MAGIC)) != 0) {
+            return false;
+        }
+        const uint64_t index_offset = show::get64(footer);
+        const uint32_t count = show::get32(footer + 8);
+        if (std::fseek(this->fp, static_cast<long>(index_offset), SEEK_SET) != 0) {
+            return false;
+        }
+        this->index.resize(count);
+        for (auto &entry : this->index) {
+            uint8_t buffer[show::INDEX_ENTRY_SIZE];
+            if (std::fread(buffer, 1, sizeof(buffer), this->fp) != sizeof(buffer)) {
+                this->index.clear();
+                return false;
+            }
+            entry.time_us = show::get64(buffer);
+            entry.offset = show::get64(buffer + 8);
+        }
+        this->duration_us = show::get64(footer + 12);
+        return true;
+    }
+
+    // the recording was not closed: find the key frames by skipping the payloads
+    void scanIndex()
+    {
+        std::fseek(this->fp, show::HEADER_SIZE, SEEK_SET);
+        uint64_t time_us = 0;
+        uint8_t header[show::RECORD_HEADER_SIZE];
+        while (true) {
+            const long offset = std::ftell(this->fp);
+            if (std::fread(header, 1, sizeof(header), this->fp) != sizeof(header)) {
+                break;
+            }
+            const show::RecordType type = static_cast<show::RecordType>(header[0]);
+            const uint16_t payload_size = show::get16(header + 6);
+            if (type == show::RecordType::End) {
+                break;
+            }
+            time_us += show::get32(header + 8);
+            if (type == show::RecordType::KeyFrame) {
+                uint8_t payload[8];
+                if (payload_size < sizeof(payload) || std::fread(payload, 1, sizeof(payload), this->fp) != sizeof(payload)) {
+                    break;
+                }
+                time_us = show::get64(payload);
+                this->index.push_back(show::KeyFrameIndex {time_us, static_cast<uint64_t>(offset)});
+                std::fseek(this->fp, static_cast<long>(payload_size - sizeof(payload)), SEEK_CUR);
+            } else {
+                std::fseek(this->fp, payload_size, SEEK_CUR);
+            }
+            this->duration_us = time_us;
+        }
+    }
+};
+
+// Plays a show file through Sender_ at the recorded timing (scaled by the speed)
+// Call update() frequently (e.g. after sleeping nextDueUs()), it sends all frames which are due.
+// Frames are sent between beginFrame() / endFrame() of the sender, so batched senders send them in one call.
+class ShowPlayer
+{
+    ShowReader reader;
+    ShowFrame pending {};
+    bool has_pending {false};
+    bool send_all {false};
+
+    String destination {"255.255.255.255"};
+    double speed {1.0};
+    bool loop {false};
+    bool generate_sync {false};
+
+    bool playing {false};
+    bool has_clock {false};
+    uint32_t last_us {0};
+    double position_us {0.0};
+
+public:
+    bool open(const char *path)
+    {
+        this->playing = false;
+        this->has_pending = false;
+        this->send_all = false;
+        this->position_us = 0.0;
+        return this->reader.open(path);
+    }
+
+    void close()
+    {
+        this->playing = false;
+        this->has_pending = false;
+        this->reader.close();
+    }
+
+    // destination of all universes (unicast or broadcast address)
+    void setDestination(const String &ip)
+    {
+        this->destination = ip;
+    }
+
+    void setSpeed(double s)
+    {
+        this->speed = s > 0.0 ? s : 1.0;
+    }
+
+    void setLoop(bool b)
+    {
+        this->loop = b;
+    }
+
+    // send ArtSync after each group of frames sent by update() (recorded ArtSync are always sent)
+    void setArtSync(bool b)
+    {
+        this->generate_sync = b;
+    }
+
+    void play()
+    {
+        this->playing = true;
+        this->has_clock = false;
+    }
+
+    void pause()
+    {
+        this->playing = false;
+    }
+
+    bool isPlaying() const
+    {
+        return this->playing;
+    }
+
+    uint64_t positionUs() const
+    {
+        return static_cast<uint64_t>(this->position_us);
+    }
+
+    uint64_t durationUs() const
+    {
+        return this->reader.durationUs();
+    }
+
+    // jump to time_us, the frames of all universes at that time are sent by the next update()
+    void seek(uint64_t time_us)
+    {
+        this->reader.seekKeyFrame(time_us);
+        this->has_pending = false;
+        // apply the records before time_us only, the first due one is decoded and sent by update() after them
+        show::RecordType type;
+        uint64_t record_us = 0;
+        ShowFrame frame;
+        while (this->reader.peek(type, record_us)) {
+            const bool is_frame = type == show::RecordType::Full || type == show::RecordType::Delta || type == show::RecordType::Sync;
+            if ((is_frame && record_us >= time_us) || !this->reader.next(frame)) {
+                break;
+            }
+        }
+        this->position_us = static_cast<double>(time_us);
+        this->send_all = true;
+        this->has_clock = false;
+    }
+
+    /// @brief Send the frames which are due
+    /// @return number of ArtDmx sent
+    template <typename S, size_t N>
+    size_t update(Sender_<S, N> &sender)
+    {
+        if (!this->playing || !this->reader.isOpen()) {
+            return 0;
+        }
+        const uint32_t now = Clock<S>::micros();
+        if (this->has_clock) {
+            this->position_us += static_cast<double>(elapsed(now, this->last_us)) * this->speed;
+        }
+        this->has_clock = true;
+        this->last_us = now;
+
+        size_t num_sent = 0;
+        bool synced = false;
+        sender.beginFrame();
+        if (this->send_all) {
+            this->send_all = false;
+            this->reader.forEachUniverse([&](uint16_t universe, const uint8_t *data, uint16_t size) {
+                sender.sendArtDmx(this->destination, universe, data, size);
+                ++num_sent;
+            });
+        }
+        while (this->loadPending() && static_cast<double>(this->pending.time_us) <= this->position_us) {
+            if (this->pending.type == show::RecordType::Full) {
+                sender.sendArtDmx(this->destination, this->pending.universe, this->pending.data, this->pending.size);
+                ++num_sent;
+                synced = false;
+            } else if (this->pending.type == show::RecordType::Sync) {
+#if ARTNET_ENABLE_ART_SYNC
+                sender.sendArtSync(this->destination);
+#endif
+                synced = true;
+            }
+            this->has_pending = false;
+        }
+#if ARTNET_ENABLE_ART_SYNC
+        if (this->generate_sync && num_sent && !synced) {
+            sender.sendArtSync(this->destination);
+        }
+#else
+        (void)synced;
+#endif
+        sender.endFrame();
+
+        if (!this->loadPending()) {
+            if (this->loop && this->reader.durationUs() > 0) {
+                this->reader.rewind();
+                this->position_us = 0.0;
+            } else {
+                this->playing = false;
+            }
+        }
+        return num_sent;
+    }
+
+    // microseconds until the next frame is due in real time (UINT32_MAX if not playing)
+    uint32_t nextDueUs()
+    {
+        if (!this->playing || !this->loadPending()) {
+            return UINT32_MAX;
+        }
+        const double wait = (static_cast<double>(this->pending.time_us) - this->position_us) / this->speed;
+        return wait <= 0.0 ? 0 : wait >= static_cast<double>(UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(wait);
+    }
+
+private:
+    // next frame to send (key frame records are applied by the reader and skipped)
+    bool loadPending()
+    {
+        while (!this->has_pending) {
+            if (!this->reader.next(this->pending)) {
+                return false;
+            }
+            this->has_pending = this->pending.type == show::RecordType::Full || this->pending.type == show::RecordType::Sync;
+        }
+        return true;
+    }
+};
+
+} // namespace host
+} // namespace art_net
+
+#endif // ARTNET_HOST_SHOW_H
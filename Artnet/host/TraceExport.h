@@ -0,0 +1,46 @@
+#pragma once
+#ifndef ARTNET_HOST_TRACE_EXPORT_H
+#define ARTNET_HOST_TRACE_EXPORT_H
+
+#include "../Trace.h"
+#include <cstdio>
+#include <vector>
+
+namespace art_net {
+namespace host {
+
+#if ARTNET_ENABLE_TRACE
+
+/// @brief Write the records in the trace buffer as Chrome trace JSON (open with chrome://tracing or ui.perfetto.dev)
+/// @return number of records written, or -1 if the file could not be opened
+inline int writeChromeTrace(const char *path)
+{
+    std::vector<trace::Record> records(trace::Buffer::capacity());
+    records.resize(trace::buffer().snapshot(records.data(), records.size()));
+
+    FILE *fp = std::fopen(path, "w");
+    if (!fp) {
+        return -1;
+    }
+    std::fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    for (size_t i = 0; i < records.size(); ++i) {
+        const trace::Record &r = records[i];
+        // complete event ("X") with the begin time and the duration in microseconds
+        std::fprintf(fp, "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%u,\"dur\":%u,\"pid\":0,\"tid\":%u",
+            trace::nameOf(r.event), r.begin_us, r.duration_us, static_cast<unsigned>(r.thread));
+        if (r.universe != trace::NO_UNIVERSE) {
+            std::fprintf(fp, ",\"args\":{\"universe\":%u}", static_cast<unsigned>(r.universe));
+        }
+        std::fprintf(fp, "}%s\n", i + 1 < records.size() ? "," : "");
+    }
+    std::fprintf(fp, "]}\n");
+    std::fclose(fp);
+    return static_cast<int>(records.size());
+}
+
+#endif
+
+} // namespace host
+} // namespace art_net
+
+#endif // ARTNET_HOST_TRACE_EXPORT_H
@@ -71,5 +71,6 @@ inline bool isNetworkReady<ETHUdp>()
 using ArtnetETH = art_net::Manager<ETHUdp>;
 using ArtnetETHSender = art_net::Sender<ETHUdp>;
 using ArtnetETHReceiver = art_net::Receiver<ETHUdp>;
+using ArtnetETHCompact = art_net::CompactManager<ETHUdp>;
 
 #endif // ARTNET_ETH_H
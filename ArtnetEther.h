@@ -70,5 +70,6 @@ inline bool isNetworkReady<EthernetUDP>()
 using ArtnetEther = art_net::Manager<EthernetUDP>;
 using ArtnetEtherSender = art_net::Sender<EthernetUDP>;
 using ArtnetEtherReceiver = art_net::Receiver<EthernetUDP>;
+using ArtnetEtherCompact = art_net::CompactManager<EthernetUDP>;
 
 #endif  // ARTNET_ETHER_H
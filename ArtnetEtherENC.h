@@ -70,5 +70,6 @@ inline bool isNetworkReady<EthernetUDP>()
 using ArtnetEtherENC = art_net::Manager<EthernetUDP>;
 using ArtnetEtherENCSender = art_net::Sender<EthernetUDP>;
 using ArtnetEtherENCReceiver = art_net::Receiver<EthernetUDP>;
+using ArtnetEtherENCCompact = art_net::CompactManager<EthernetUDP>;
 
 #endif  // ARTNET_ETHER_H
@@ -0,0 +1,195 @@
+#pragma once
+#ifndef ARTNET_LINUX_H
+#define ARTNET_LINUX_H
+
+// Host (Linux/POSIX) front-end: build and run Manager/Sender/Receiver natively with non-blocking sockets
+// See extras/host for CMake build, examples and tools
+
+#include "Artnet/host/ArduinoShim.h"
+#include <ArxTypeTraits.h>
+#include <ArxContainer.h>
+#include "Artnet/host/PosixUDP.h"
+#include "Artnet/host/PosixUDPBatch.h"
+#include "Artnet/host/LoopbackUDP.h"
+#include "Artnet/ReceiverTraits.h"
+#include "Artnet/SenderTraits.h"
+#include "Artnet/Clock.h"
+
+namespace art_net {
+
+template <>
+struct LocalIP<PosixNetworkClass>
+{
+    static IPAddress get(PosixNetworkClass& network)
+    {
+        return network.localIP();
+    }
+};
+
+template <>
+struct SubnetMask<PosixNetworkClass>
+{
+    static IPAddress get(PosixNetworkClass& network)
+    {
+        return network.subnetMask();
+    }
+};
+
+template <>
+struct MacAddress<PosixNetworkClass>
+{
+    static void get(PosixNetworkClass& network, uint8_t mac[6])
+    {
+        network.macAddress(mac);
+    }
+};
+
+template <>
+struct IsNetworkReady<PosixNetworkClass>
+{
+    static bool get(PosixNetworkClass& network)
+    {
+        return network.isReady();
+    }
+};
+
+template <>
+inline IPAddress getLocalIP<PosixUDP>()
+{
+    return LocalIP<PosixNetworkClass>::get(PosixNetwork);
+}
+
+template <>
+inline IPAddress getSubnetMask<PosixUDP>()
+{
+    return SubnetMask<PosixNetworkClass>::get(PosixNetwork);
+}
+
+template <>
+inline void getMacAddress<PosixUDP>(uint8_t mac[6])
+{
+    MacAddress<PosixNetworkClass>::get(PosixNetwork, mac);
+}
+
+template <>
+inline bool isNetworkReady<PosixUDP>()
+{
+    return IsNetworkReady<PosixNetworkClass>::get(PosixNetwork);
+}
+
+template <>
+inline IPAddress getLocalIP<PosixUDPBatch>()
+{
+    return LocalIP<PosixNetworkClass>::get(PosixNetwork);
+}
+
+template <>
+inline IPAddress getSubnetMask<PosixUDPBatch>()
+{
+    return SubnetMask<PosixNetworkClass>::get(PosixNetwork);
+}
+
+template <>
+inline void getMacAddress<PosixUDPBatch>(uint8_t mac[6])
+{
+    MacAddress<PosixNetworkClass>::get(PosixNetwork, mac);
+}
+
+template <>
+inline bool isNetworkReady<PosixUDPBatch>()
+{
+    return IsNetworkReady<PosixNetworkClass>::get(PosixNetwork);
+}
+
+// NOTE: these traits have no access to the stream, so ArtPollReply from LoopbackUDP has the address of the network (10.0.0.0)
+//       The address of each endpoint is still available as remoteIP() on the other side.
+template <>
+inline IPAddress getLocalIP<LoopbackUDP>()
+{
+    return IPAddress(10, 0, 0, 0);
+}
+
+template <>
+inline IPAddress getSubnetMask<LoopbackUDP>()
+{
+    return host::LoopbackNetwork::subnetMask();
+}
+
+template <>
+inline void getMacAddress<LoopbackUDP>(uint8_t mac[6])
+{
+    memset(mac, 0, 6);
+}
+
+template <>
+inline bool isNetworkReady<LoopbackUDP>()
+{
+    return true;
+}
+
+// Sender / Receiver on LoopbackUDP follow the time of loopbackNetwork() (e.g. fast-forward by advanceUs() with virtual time)
+template <>
+struct Clock<LoopbackUDP>
+{
+    static uint32_t millis() { return static_cast<uint32_t>(host::loopbackNetwork().nowUs() / 1000); }
+    static uint32_t micros() { return static_cast<uint32_t>(host::loopbackNetwork().nowUs()); }
+    static long random(long max) { return host::loopbackNetwork().random(max); }
+};
+
+template <>
+struct FileDescriptor<PosixUDP>
+{
+    static int get(const PosixUDP& udp)
+    {
+        return udp.fd();
+    }
+};
+
+template <>
+struct FileDescriptor<PosixUDPBatch>
+{
+    static int get(const PosixUDPBatch& udp)
+    {
+        return udp.fd();
+    }
+};
+
+template <>
+struct SendBatch<PosixUDPBatch>
+{
+    static void begin(PosixUDPBatch& udp)
+    {
+        udp.beginBatch();
+    }
+    static void end(PosixUDPBatch& udp)
+    {
+        udp.endBatch();
+    }
+};
+
+} // namespace art_net
+
+#include "Artnet/Manager.h"
+#include "Artnet/host/ShardedReceiver.h"
+#include "Artnet/host/EventLoop.h"
+#include "Artnet/host/TraceExport.h"
+#include "Artnet/host/Pcap.h"
+#include "Artnet/host/CaptureWriter.h"
+#include "Artnet/host/Show.h"
+
+using ArtnetLinux = art_net::Manager<PosixUDP>;
+using ArtnetLinuxSender = art_net::Sender<PosixUDP>;
+using ArtnetLinuxReceiver = art_net::Receiver<PosixUDP>;
+using ArtnetLinuxCompact = art_net::CompactManager<PosixUDP>;
+
+// recvmmsg() / sendmmsg() batched I/O (use beginFrame() / endFrame() to send a frame in one call)
+using ArtnetLinuxBatch = art_net::Manager<PosixUDPBatch>;
+using ArtnetLinuxBatchSender = art_net::Sender<PosixUDPBatch>;
+using ArtnetLinuxBatchReceiver = art_net::Receiver<PosixUDPBatch>;
+
+// in-memory network in one process (see art_net::host::LoopbackNetwork)
+using ArtnetLoopback = art_net::Manager<LoopbackUDP>;
+using ArtnetLoopbackSender = art_net::Sender<LoopbackUDP>;
+using ArtnetLoopbackReceiver = art_net::Receiver<LoopbackUDP>;
+
+#endif  // ARTNET_LINUX_H
@@ -70,5 +70,6 @@ inline bool isNetworkReady<EthernetUDP>()
 using ArtnetNativeEther = art_net::Manager<EthernetUDP>;
 using ArtnetNativeEtherSender = art_net::Sender<EthernetUDP>;
 using ArtnetNativeEtherReceiver = art_net::Receiver<EthernetUDP>;
+using ArtnetNativeEtherCompact = art_net::CompactManager<EthernetUDP>;
 
 #endif  // ARTNET_NATIVE_ETHER_H
@@ -129,5 +129,6 @@ inline bool isNetworkReady<WiFiUDP>()
 using ArtnetWiFi = art_net::Manager<WiFiUDP>;
 using ArtnetWiFiSender = art_net::Sender<WiFiUDP>;
 using ArtnetWiFiReceiver = art_net::Receiver<WiFiUDP>;
+using ArtnetWiFiCompact = art_net::CompactManager<WiFiUDP>;
 
 #endif  // ARTNET_WIFI_H
@@ -0,0 +1,59 @@
+#include <ArtnetETH.h>
+#include <Artnet/PipelineReceiver.h>
+
+// Read Art-Net packets on core 0 and run callbacks (e.g. LED rendering, DMX output) in loop() on core 1,
+// so that a slow callback never causes overflow of the socket
+
+// Ethernet stuff
+const IPAddress ip(192, 168, 0, 201);
+const IPAddress gateway(192, 168, 0, 1);
+const IPAddress subnet_mask(255, 255, 255, 0);
+
+// 16 packet slots between the read task and loop()
+art_net::PipelineReceiver<ETHUdp, 16> artnet;
+uint16_t universe = 1;  // 0 - 32767
+
+void receiveTask(void *) {
+    while (true) {
+        if (artnet.receive() == 0) {
+            delay(1);
+        }
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+
+    ETH.begin();
+    ETH.config(ip, gateway, subnet_mask);
+    artnet.begin();
+
+    // this callback runs in loop() by dispatch()
+    artnet.subscribeArtDmxUniverse(universe, [&](const uint8_t *data, uint16_t size, const ArtDmxMetadata &metadata, const ArtNetRemoteInfo &remote) {
+        Serial.print("universe = ");
+        Serial.print(universe);
+        Serial.print(", sequence = ");
+        Serial.print(metadata.sequence);
+        Serial.print(", size = ");
+        Serial.println(size);
+        delay(20);  // slow rendering
+    });
+
+    // start reading after subscriptions
+    xTaskCreatePinnedToCore(receiveTask, "artnet_receive", 4096, nullptr, 1, nullptr, 0);
+}
+
+void loop() {
+    artnet.dispatch();  // run callbacks for the received packets
+
+    static uint32_t prev_ms = millis();
+    if (millis() - prev_ms >= 1000) {
+        prev_ms = millis();
+        Serial.print("ring occupancy = ");
+        Serial.print(artnet.occupancy());
+        Serial.print(" / ");
+        Serial.print(artnet.capacity());
+        Serial.print(", drops = ");
+        Serial.println(artnet.drops());
+    }
+}
@@ -0,0 +1,51 @@
+#include <ArtnetEther.h>
+
+// print static RAM footprint (sizeof) of each configuration
+// NOTE: the objects are not instantiated, so this sketch itself does not consume them
+
+template <typename T>
+void printSize(const char* name) {
+    Serial.print(name);
+    Serial.print(" : ");
+    Serial.print(sizeof(T));
+    Serial.println(" bytes");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.print("DEFAULT_MAX_UNIVERSES = ");
+    Serial.println(art_net::DEFAULT_MAX_UNIVERSES);
+    Serial.print("DEFAULT_MAX_DESTINATIONS = ");
+    Serial.println(art_net::DEFAULT_MAX_DESTINATIONS);
+
+    printSize<ArtnetEtherReceiver>("ArtnetEtherReceiver (default)");
+    printSize<art_net::Receiver<EthernetUDP, 0>>("Receiver<EthernetUDP, 0>");
+    printSize<art_net::Receiver<EthernetUDP, 1>>("Receiver<EthernetUDP, 1>");
+    printSize<art_net::Receiver<EthernetUDP, 8>>("Receiver<EthernetUDP, 8>");
+    printSize<art_net::Receiver<EthernetUDP, 16>>("Receiver<EthernetUDP, 16>");
+
+    printSize<ArtnetEtherSender>("ArtnetEtherSender (default)");
+    printSize<art_net::Sender<EthernetUDP, 1>>("Sender<EthernetUDP, 1>");
+    printSize<art_net::Sender<EthernetUDP, 8>>("Sender<EthernetUDP, 8>");
+    printSize<art_net::Sender<EthernetUDP, 16>>("Sender<EthernetUDP, 16>");
+
+    printSize<ArtnetEther>("ArtnetEther (default)");
+    printSize<art_net::Manager<EthernetUDP, 1, 1>>("Manager<EthernetUDP, 1, 1>");
+    printSize<art_net::Manager<EthernetUDP, 8, 8>>("Manager<EthernetUDP, 8, 8>");
+
+    // Sender and Receiver share one packet buffer (saves art_net::PACKET_SIZE bytes)
+    printSize<ArtnetEtherCompact>("ArtnetEtherCompact (default)");
+    printSize<art_net::CompactManager<EthernetUDP, 1, 1>>("CompactManager<EthernetUDP, 1, 1>");
+    printSize<art_net::CompactManager<EthernetUDP, 8, 8>>("CompactManager<EthernetUDP, 8, 8>");
+
+    // all runtime state of Manager (packet buffers, subscriptions, sequences and timers) is in this block
+    using art_net::ManagerState;
+    using art_net::PacketBufferMode;
+    printSize<ManagerState<art_net::DEFAULT_MAX_UNIVERSES, art_net::DEFAULT_MAX_DESTINATIONS, PacketBufferMode::Separate>>("ManagerState (default, Separate)");
+    printSize<ManagerState<art_net::DEFAULT_MAX_UNIVERSES, art_net::DEFAULT_MAX_DESTINATIONS, PacketBufferMode::Shared>>("ManagerState (default, Shared)");
+}
+
+void loop() {
+}
@@ -0,0 +1,49 @@
+#include <ArtnetEther.h>
+// #include <ArtnetNativeEther.h>  // only for Teensy 4.1
+
+// Ethernet stuff
+const IPAddress ip(192, 168, 0, 201);
+uint8_t mac[] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB};
+
+// handlers are resolved at compile time and called directly from parse()
+struct DimmerHandler
+{
+    static void onArtDmx(const uint8_t *data, uint16_t size, const ArtDmxMetadata &metadata, const ArtNetRemoteInfo &remote)
+    {
+        Serial.print("dimmer : universe = ");
+        Serial.print(metadata.universe);
+        Serial.print(", ch1 = ");
+        Serial.println(data[0]);
+    }
+};
+
+struct MovingHeadHandler
+{
+    static void onArtDmx(const uint8_t *data, uint16_t size, const ArtDmxMetadata &metadata, const ArtNetRemoteInfo &remote)
+    {
+        Serial.print("moving head : universe = ");
+        Serial.print(metadata.universe);
+        Serial.print(", size = ");
+        Serial.println(size);
+    }
+};
+
+// universe (15 bit) -> handler
+using Routes = ArtDmxRoutes<
+    ArtDmxRoute<1, DimmerHandler>,
+    ArtDmxRoute<2, MovingHeadHandler>
+>;
+// runtime subscription slots are not needed if all universes are routed statically
+const size_t max_runtime_universes = 0;
+art_net::Receiver<EthernetUDP, max_runtime_universes, Routes> artnet;
+
+void setup() {
+    Serial.begin(115200);
+
+    Ethernet.begin(mac, ip);
+    artnet.begin();
+}
+
+void loop() {
+    artnet.parse();  // check if artnet packet has come and call the routed handlers
+}
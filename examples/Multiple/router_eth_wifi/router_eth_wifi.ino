@@ -0,0 +1,64 @@
+#include <ArtnetETH.h>
+#include <ArtnetWiFi.h>
+#include <Artnet/Router.h>
+
+// Bridge a wired console (Ethernet) to pixel nodes on WiFi
+// ArtDmx of the routed universes are forwarded with only the universe and the sequence rewritten (no copy of the payload)
+
+// WiFi stuff
+const char* ssid = "your-ssid";
+const char* pwd = "your-password";
+const IPAddress ip_wifi(192, 168, 1, 201);
+const IPAddress gateway_wifi(192, 168, 1, 1);
+const IPAddress subnet(255, 255, 255, 0);
+// Ethernet stuff
+const IPAddress ip_ether(192, 168, 0, 201);
+const IPAddress gateway_ether(192, 168, 0, 1);
+
+ArtnetETHReceiver artnet_ether;
+ArtnetWiFiSender artnet_wifi;
+art_net::Router<ArtnetETHReceiver, ArtnetWiFiSender> router(artnet_ether, artnet_wifi);
+
+void setup() {
+    Serial.begin(115200);
+
+    // WiFi stuff
+    WiFi.begin(ssid, pwd);
+    WiFi.config(ip_wifi, gateway_wifi, subnet);
+    while (WiFi.status() != WL_CONNECTED) {
+        Serial.print(".");
+        delay(500);
+    }
+    Serial.print("WiFi connected, IP = ");
+    Serial.println(WiFi.localIP());
+    artnet_wifi.begin();
+
+    // Ethernet stuff
+    ETH.begin();
+    ETH.config(ip_ether, gateway_ether, subnet);
+    artnet_ether.begin();
+
+    // universe (15 bit) on Ethernet -> node on WiFi (and its universe)
+    router.addRoute(0, "192.168.1.100");
+    router.addRoute(1, "192.168.1.100");
+    router.addRoute(2, "192.168.1.101", 0);
+
+    // other universes and packets are dispatched to the callbacks of the receiver as usual
+    artnet_ether.subscribeArtSync([](const ArtNetRemoteInfo &remote) {
+        artnet_wifi.sendArtSync("192.168.1.255");
+    });
+}
+
+void loop() {
+    router.route();  // instead of artnet_ether.parse()
+
+    static uint32_t prev_ms = millis();
+    if (millis() - prev_ms >= 1000) {
+        prev_ms = millis();
+        const art_net::RouteStats *stats = router.routeStats(1);
+        Serial.print("universe 1: forwarded = ");
+        Serial.print(stats->forwarded);
+        Serial.print(", send failures = ");
+        Serial.println(stats->send_failures);
+    }
+}
@@ -0,0 +1,58 @@
+#include <ArtnetWiFi.h>
+#include <Artnet/CoalescingReceiver.h>
+
+// Skip stale frames queued in the socket while loop() was blocked,
+// and render only the newest frame of each universe
+
+// WiFi stuff
+const char* ssid = "your-ssid";
+const char* pwd = "your-password";
+const IPAddress ip(192, 168, 1, 201);
+const IPAddress gateway(192, 168, 1, 1);
+const IPAddress subnet_mask(255, 255, 255, 0);
+
+// keep the newest packets of up to 4 universes at once
+art_net::CoalescingReceiver<WiFiUDP, 4> artnet;
+uint16_t universe = 1;  // 0 - 32767
+
+void setup() {
+    Serial.begin(115200);
+
+    // WiFi stuff
+    WiFi.begin(ssid, pwd);
+    WiFi.config(ip, gateway, subnet_mask);
+    while (WiFi.status() != WL_CONNECTED) {
+        Serial.print(".");
+        delay(500);
+    }
+    Serial.print("WiFi connected, IP = ");
+    Serial.println(WiFi.localIP());
+
+    artnet.begin();
+
+    artnet.subscribeArtDmxUniverse(universe, [&](const uint8_t *data, uint16_t size, const ArtDmxMetadata &metadata, const ArtNetRemoteInfo &remote) {
+        Serial.print("universe = ");
+        Serial.print(universe);
+        Serial.print(", sequence = ");
+        Serial.print(metadata.sequence);
+        Serial.print(", size = ");
+        Serial.println(size);
+    });
+
+    // ArtSync is dispatched after the newest data of its frame
+    artnet.subscribeArtSync([](const ArtNetRemoteInfo &remote) {
+        Serial.println("ArtSync");
+    });
+}
+
+void loop() {
+    artnet.drain();  // read all queued packets and execute callbacks for the newest ones
+
+    static uint32_t prev_ms = millis();
+    if (millis() - prev_ms >= 1000) {
+        prev_ms = millis();
+        Serial.print("coalesced = ");
+        Serial.println(artnet.coalesced());
+        delay(500);  // stall (e.g. flash write) which makes a backlog of stale frames
+    }
+}
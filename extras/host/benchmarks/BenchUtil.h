@@ -0,0 +1,107 @@
+#pragma once
+#ifndef ARTNET_HOST_BENCH_UTIL_H
+#define ARTNET_HOST_BENCH_UTIL_H
+
+#include <ArtnetLinux.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+constexpr size_t MAX_UNIVERSES = 4096;
+
+// Sender / Receiver which expose the stream to read syscall statistics
+template <typename S>
+struct Sender : art_net::Sender_<S, MAX_UNIVERSES>
+{
+    S stream;
+    uint8_t packet_buffer[art_net::PACKET_SIZE];
+    art_net::SenderState<MAX_UNIVERSES> sender_state;
+
+    Sender()
+    {
+        this->attachPacketBuffer(this->packet_buffer);
+        this->attachState(this->sender_state);
+    }
+    // bind any free local port so that the receiver on the same host can use the Art-Net port
+    void begin(uint16_t port = 0)
+    {
+        this->stream.begin(port);
+        this->attach(this->stream);
+    }
+};
+
+template <typename S>
+struct Receiver : art_net::Receiver_<S, MAX_UNIVERSES>
+{
+    S stream;
+    uint8_t packet_buffer[art_net::PACKET_SIZE];
+    art_net::ReceiverState<MAX_UNIVERSES> receiver_state;
+
+    Receiver()
+    {
+        this->attachPacketBuffer(this->packet_buffer);
+        this->attachState(this->receiver_state);
+    }
+    void begin(uint16_t port = art_net::DEFAULT_PORT)
+    {
+        this->stream.begin(port);
+        this->attach(this->stream);
+    }
+};
+
+inline double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Result of one micro benchmark case
+struct Measurement
+{
+    std::string group;  // e.g. "parse"
+    std::string name;   // e.g. "dmx"
+    uint64_t param;     // e.g. number of universes (0 if not used)
+    uint64_t iterations;
+    double ns_per_op;
+};
+
+// run func() repeatedly (doubling the iterations) until it takes min_seconds
+template <typename F>
+Measurement measure(const char *group, const char *name, uint64_t param, F &&func, double min_seconds = 0.2)
+{
+    // warm up caches and branch predictors
+    for (size_t i = 0; i < 100; ++i) {
+        func();
+    }
+    uint64_t iterations = 1000;
+    while (true) {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            func();
+        }
+        const double elapsed = secondsSince(start);
+        if (elapsed >= min_seconds || iterations >= (1ull << 32)) {
+            return Measurement {group, name, param, iterations, elapsed * 1e9 / static_cast<double>(iterations)};
+        }
+        iterations *= 2;
+    }
+}
+
+// print results as a JSON document to track regressions
+inline void printJson(FILE *fp, const char *version, const std::vector<Measurement> &results)
+{
+    std::fprintf(fp, "{\n  \"version\": \"%s\",\n  \"results\": [\n", version);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Measurement &m = results[i];
+        std::fprintf(fp, "    {\"group\": \"%s\", \"name\": \"%s\", \"param\": %llu, \"iterations\": %llu, \"ns_per_op\": %.2f}%s\n",
+            m.group.c_str(), m.name.c_str(), static_cast<unsigned long long>(m.param), static_cast<unsigned long long>(m.iterations),
+            m.ns_per_op, i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(fp, "  ]\n}\n");
+}
+
+} // namespace bench
+
+#endif // ARTNET_HOST_BENCH_UTIL_H
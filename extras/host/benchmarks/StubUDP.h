@@ -0,0 +1,103 @@
+#pragma once
+#ifndef ARTNET_HOST_STUB_UDP_H
+#define ARTNET_HOST_STUB_UDP_H
+
+#include <ArtnetLinux.h>
+#include <vector>
+
+// UDP stream without network to measure the CPU cost of the library itself
+// - parsePacket() returns the datagram set by setPacket() every time (no syscall)
+// - sent packets are discarded and only counted
+class StubUDP
+{
+    std::vector<uint8_t> rx;
+    size_t rx_pos {0};
+    size_t tx_size {0};
+
+public:
+    uint64_t sent_packets {0};
+    uint64_t sent_bytes {0};
+
+    uint8_t begin(uint16_t) { return 1; }
+    void stop() {}
+
+    void setPacket(const uint8_t *data, size_t size)
+    {
+        this->rx.assign(data, data + size);
+    }
+
+    // receive
+
+    int parsePacket()
+    {
+        this->rx_pos = 0;
+        return static_cast<int>(this->rx.size());
+    }
+    int available() const { return static_cast<int>(this->rx.size() - this->rx_pos); }
+    int read(uint8_t *buffer, size_t len)
+    {
+        const size_t n = len < this->rx.size() - this->rx_pos ? len : this->rx.size() - this->rx_pos;
+        memcpy(buffer, this->rx.data() + this->rx_pos, n);
+        this->rx_pos += n;
+        return static_cast<int>(n);
+    }
+    void flush() { this->rx_pos = this->rx.size(); }
+    IPAddress remoteIP() const { return IPAddress(192, 168, 0, 100); }
+    uint16_t remotePort() const { return art_net::DEFAULT_PORT; }
+
+    // send
+
+    int beginPacket(IPAddress, uint16_t)
+    {
+        this->tx_size = 0;
+        return 1;
+    }
+    int beginPacket(const char *, uint16_t)
+    {
+        this->tx_size = 0;
+        return 1;
+    }
+    size_t write(const uint8_t *, size_t size)
+    {
+        this->tx_size += size;
+        return size;
+    }
+    int endPacket()
+    {
+        ++this->sent_packets;
+        this->sent_bytes += this->tx_size;
+        return 1;
+    }
+};
+
+namespace art_net {
+
+template <>
+inline IPAddress getLocalIP<StubUDP>()
+{
+    return IPAddress(192, 168, 0, 201);
+}
+
+template <>
+inline IPAddress getSubnetMask<StubUDP>()
+{
+    return IPAddress(255, 255, 255, 0);
+}
+
+template <>
+inline void getMacAddress<StubUDP>(uint8_t mac[6])
+{
+    for (size_t i = 0; i < 6; ++i) {
+        mac[i] = static_cast<uint8_t>(i);
+    }
+}
+
+template <>
+inline bool isNetworkReady<StubUDP>()
+{
+    return true;
+}
+
+} // namespace art_net
+
+#endif // ARTNET_HOST_STUB_UDP_H
@@ -0,0 +1,100 @@
+// Compare single-datagram I/O (PosixUDP: recvfrom/sendto) and batched I/O (PosixUDPBatch: recvmmsg/sendmmsg)
+// over loopback. The main thread sends frames of ArtDmx packets (one packet per universe) as fast as possible,
+// and a receiver thread drains them through Receiver_::parse().
+//
+// usage: batch_io [universes=512] [seconds=2]
+
+#include "BenchUtil.h"
+#include <atomic>
+#include <thread>
+
+namespace {
+
+struct Result
+{
+    double seconds;
+    uint64_t frames;
+    art_net::host::SocketStats tx;
+    art_net::host::SocketStats rx;
+    uint64_t dispatched;
+};
+
+template <typename S>
+Result run(uint16_t num_universes, double seconds)
+{
+    bench::Receiver<S> receiver;
+    receiver.begin();
+    uint64_t dispatched = 0;
+    receiver.subscribeArtDmx([&](const uint8_t *, uint16_t, const ArtDmxMetadata &, const ArtNetRemoteInfo &) {
+        ++dispatched;
+    });
+
+    std::atomic<bool> running {true};
+    std::thread rx_thread([&] {
+        while (running) {
+            receiver.parse();
+        }
+        // drain the rest
+        while (receiver.parse() != art_net::OpCode::NoPacket) {
+        }
+    });
+
+    bench::Sender<S> sender;
+    sender.begin();
+    const String ip = "127.0.0.1";
+    uint8_t data[512];
+    memset(data, 0x7F, sizeof(data));
+
+    Result result {};
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + std::chrono::duration<double>(seconds);
+    while (std::chrono::steady_clock::now() < end) {
+        sender.beginFrame();
+        for (uint16_t u = 0; u < num_universes; ++u) {
+            sender.sendArtDmx(ip, u, data, sizeof(data));
+        }
+        sender.endFrame();
+        ++result.frames;
+    }
+    result.seconds = bench::secondsSince(start);
+
+    delay(100);
+    running = false;
+    rx_thread.join();
+
+    result.tx = sender.stream.stats();
+    result.rx = receiver.stream.stats();
+    result.dispatched = dispatched;
+    return result;
+}
+
+void print(const char *name, const Result &r, uint16_t num_universes)
+{
+    const double frames = static_cast<double>(r.frames);
+    const double rx_frames = static_cast<double>(r.rx.rx_datagrams) / num_universes;
+    printf("%-8s %12.0f %12.2f %12.0f %12.2f %10.2f\n",
+        name,
+        r.tx.tx_datagrams / r.seconds,
+        r.tx.tx_syscalls / frames,
+        r.dispatched / r.seconds,
+        rx_frames > 0 ? r.rx.rx_syscalls / rx_frames : 0.0,
+        r.tx.tx_datagrams ? 100.0 * (1.0 - static_cast<double>(r.dispatched) / r.tx.tx_datagrams) : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const uint16_t num_universes = static_cast<uint16_t>(argc > 1 ? atoi(argv[1]) : 512);
+    const double seconds = argc > 2 ? atof(argv[2]) : 2.0;
+    if (num_universes == 0 || num_universes > bench::MAX_UNIVERSES) {
+        fprintf(stderr, "universes should be 1 - %zu\n", bench::MAX_UNIVERSES);
+        return 1;
+    }
+
+    printf("universes per frame: %u, duration: %.1f s\n", num_universes, seconds);
+    printf("%-8s %12s %12s %12s %12s %10s\n", "mode", "tx pkt/s", "tx sys/frame", "rx pkt/s", "rx sys/frame", "loss %");
+    print("single", run<PosixUDP>(num_universes, seconds), num_universes);
+    print("batch", run<PosixUDPBatch>(num_universes, seconds), num_universes);
+    return 0;
+}
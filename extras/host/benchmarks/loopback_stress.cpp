@@ -0,0 +1,136 @@
+// Stress run of Sender -> Receiver over the in-memory LoopbackNetwork (no sockets)
+// Frames of ArtDmx (one packet per universe) are sent at the given fps in virtual time, so that minutes of streaming
+// finish as fast as the CPU allows, with loss / reorder / jitter injected by a seeded PRNG (reproducible).
+// A controller broadcasts ArtPoll every second and counts ArtPollReply from the receiver.
+//
+// usage: loopback_stress [universes=1000] [fps=44] [seconds=10] [loss=0.01] [reorder=0.001] [jitter_us=0] [seed=1]
+
+#include "BenchUtil.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+size_t makeArtPoll(uint8_t *packet)
+{
+    memset(packet, 0, 14);
+    memcpy(packet, art_net::ARTNET_ID, sizeof(art_net::ARTNET_ID));
+    packet[art_net::art_dmx::OP_CODE_L] = 0x00;
+    packet[art_net::art_dmx::OP_CODE_H] = 0x20;
+    packet[art_net::art_dmx::PROTOCOL_VER_L] = art_net::PROTOCOL_VER;
+    return 14;
+}
+
+uint32_t countPollReplies(LoopbackUDP &controller)
+{
+    uint32_t n = 0;
+    uint8_t header[10];
+    while (controller.parsePacket() > 0) {
+        if (controller.read(header, sizeof(header)) == sizeof(header) && header[8] == 0x00 && header[9] == 0x21) {
+            ++n;
+        }
+        controller.flush();
+    }
+    return n;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const uint16_t num_universes = static_cast<uint16_t>(argc > 1 ? atoi(argv[1]) : 1000);
+    const double fps = argc > 2 ? atof(argv[2]) : 44.0;
+    const double seconds = argc > 3 ? atof(argv[3]) : 10.0;
+    art_net::host::LoopbackConditions conditions;
+    conditions.loss = static_cast<float>(argc > 4 ? atof(argv[4]) : 0.01);
+    conditions.reorder = static_cast<float>(argc > 5 ? atof(argv[5]) : 0.001);
+    conditions.jitter_us = static_cast<uint32_t>(argc > 6 ? atoi(argv[6]) : 0);
+    conditions.queue_depth = 4 * static_cast<size_t>(num_universes);
+    const uint32_t seed = static_cast<uint32_t>(argc > 7 ? atoi(argv[7]) : 1);
+    if (num_universes == 0 || num_universes > bench::MAX_UNIVERSES || fps <= 0.0) {
+        fprintf(stderr, "universes should be 1 - %zu and fps > 0\n", bench::MAX_UNIVERSES);
+        return 1;
+    }
+
+    art_net::host::LoopbackNetwork &network = art_net::host::loopbackNetwork();
+    network.setConditions(conditions);
+    network.seed(seed);
+    network.useVirtualTime(true);
+
+    bench::Receiver<LoopbackUDP> receiver;
+    receiver.begin();
+    std::vector<uint32_t> frames(num_universes, 0);
+    receiver.subscribeArtDmx([&](const uint8_t *, uint16_t, const ArtDmxMetadata &metadata, const ArtNetRemoteInfo &) {
+        const uint16_t u = (metadata.net << 8) | (metadata.subnet << 4) | metadata.universe;
+        if (u < frames.size()) {
+            ++frames[u];
+        }
+    });
+
+    bench::Sender<LoopbackUDP> sender;
+    sender.begin(0);
+    LoopbackUDP controller;
+    controller.begin(art_net::DEFAULT_PORT);
+
+    const String receiver_ip = receiver.stream.localIP().toString();
+    const uint64_t frame_us = static_cast<uint64_t>(1e6 / fps);
+    const uint64_t num_frames = static_cast<uint64_t>(seconds * fps);
+    const uint64_t poll_every = std::max<uint64_t>(1, static_cast<uint64_t>(fps));
+    uint8_t data[512];
+    memset(data, 0x7F, sizeof(data));
+    uint8_t poll[14];
+    uint32_t polls = 0;
+    uint32_t poll_replies = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t f = 0; f < num_frames; ++f) {
+        data[0] = static_cast<uint8_t>(f);
+        for (uint16_t u = 0; u < num_universes; ++u) {
+            sender.sendArtDmx(receiver_ip, u, data, sizeof(data));
+        }
+        if (f % poll_every == 0) {
+            controller.beginPacket(art_net::host::LoopbackNetwork::broadcastIP(), art_net::DEFAULT_PORT);
+            controller.write(poll, makeArtPoll(poll));
+            controller.endPacket();
+            ++polls;
+        }
+        network.advanceUs(frame_us);
+        while (receiver.parse() != art_net::OpCode::NoPacket) {
+        }
+        poll_replies += countPollReplies(controller);
+    }
+    // deliver datagrams still delayed or held for reordering
+    network.advanceUs(conditions.delay_us + conditions.jitter_us + conditions.reorder_timeout_us);
+    while (receiver.parse() != art_net::OpCode::NoPacket) {
+    }
+    // ArtPollReply is delayed randomly up to 1 s (in virtual time by Clock<LoopbackUDP>)
+    while (receiver.nextPollReplyDelayMs() != UINT32_MAX) {
+        network.advanceUs(1000 * static_cast<uint64_t>(receiver.nextPollReplyDelayMs() + 1));
+        receiver.update();
+    }
+    poll_replies += countPollReplies(controller);
+    const double elapsed = bench::secondsSince(start);
+
+    const art_net::host::LoopbackStats stats = network.stats();
+    const auto minmax = std::minmax_element(frames.begin(), frames.end());
+    uint64_t dispatched = 0;
+    for (const uint32_t n : frames) {
+        dispatched += n;
+    }
+
+    printf("universes: %u, fps: %.1f, simulated: %.1f s (%llu frames), loss: %.3f, reorder: %.3f, jitter: %u us, seed: %u\n",
+        num_universes, fps, num_frames / fps, static_cast<unsigned long long>(num_frames), conditions.loss, conditions.reorder,
+        conditions.jitter_us, seed);
+    printf("wall time            : %.3f s (%.1fx real time)\n", elapsed, elapsed > 0.0 ? (num_frames / fps) / elapsed : 0.0);
+    printf("throughput           : %.0f packets/s\n", elapsed > 0.0 ? dispatched / elapsed : 0.0);
+    printf("sent / delivered     : %llu / %llu\n", static_cast<unsigned long long>(stats.sent), static_cast<unsigned long long>(stats.delivered));
+    printf("lost / overflowed    : %llu / %llu\n", static_cast<unsigned long long>(stats.lost), static_cast<unsigned long long>(stats.overflowed));
+    printf("reordered            : %llu\n", static_cast<unsigned long long>(stats.reordered));
+    printf("dispatched ArtDmx    : %llu (frames per universe: min %u, max %u)\n",
+        static_cast<unsigned long long>(dispatched), *minmax.first, *minmax.second);
+#if ARTNET_ENABLE_STATS
+    printf("stale sequence       : %u\n", receiver.receiverStats().drops.stale_sequence);
+#endif
+    printf("ArtPoll / ArtPollReply: %u / %u\n", polls, poll_replies);
+    return 0;
+}
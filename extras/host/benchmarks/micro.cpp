@@ -0,0 +1,236 @@
+// CPU cost of the parse / dispatch / send paths without network (StubUDP replays one datagram, and discards sent packets)
+// Results are printed as JSON to track regressions across releases.
+//
+// usage: micro [output.json] [min_seconds_per_case=0.2]
+
+// FastLED is not available on host: minimal CRGB to measure the forwarding of forwardArtDmxDataToFastLED()
+#include <stdint.h>
+struct CRGB
+{
+    uint8_t r, g, b;
+};
+#define FASTLED_VERSION 0
+
+#include "BenchUtil.h"
+#include "StubUDP.h"
+#include <cstdlib>
+
+#ifndef ARTNET_HOST_VERSION
+#define ARTNET_HOST_VERSION "unknown"
+#endif
+
+namespace {
+
+using Receiver = bench::Receiver<StubUDP>;
+using Sender = bench::Sender<StubUDP>;
+
+uint8_t packet[art_net::PACKET_SIZE];
+volatile uint32_t sink;
+
+void noop(const uint8_t *data, uint16_t size, const ArtDmxMetadata &, const ArtNetRemoteInfo &)
+{
+    sink = data[0] + size;
+}
+
+void noopNzs(const uint8_t *data, uint16_t size, const ArtNzsMetadata &, const ArtNetRemoteInfo &)
+{
+    sink = data[0] + size;
+}
+
+size_t makeArtDmx(uint16_t universe)
+{
+    uint8_t data[512] {};
+    art_net::art_dmx::setMetadataTo(packet, 1, 0, (universe >> 8) & 0x7F, (universe >> 4) & 0x0F, universe & 0x0F);
+    art_net::art_dmx::setDataTo(packet, data, sizeof(data));
+    return art_net::PACKET_SIZE;
+}
+
+size_t makeArtNzs(uint16_t universe)
+{
+    uint8_t data[512] {};
+    art_net::art_nzs::setMetadataTo(packet, 1, 0x91, (universe >> 8) & 0x7F, (universe >> 4) & 0x0F, universe & 0x0F);
+    art_net::art_nzs::setDataTo(packet, data, sizeof(data));
+    return art_net::PACKET_SIZE;
+}
+
+size_t makeArtPoll()
+{
+    memset(packet, 0, sizeof(packet));
+    memcpy(packet, art_net::ARTNET_ID, sizeof(art_net::ARTNET_ID));
+    packet[art_net::art_dmx::OP_CODE_L] = 0x00;
+    packet[art_net::art_dmx::OP_CODE_H] = 0x20;
+    packet[art_net::art_dmx::PROTOCOL_VER_L] = art_net::PROTOCOL_VER;
+    return 14;
+}
+
+size_t makeArtSync()
+{
+    art_net::art_sync::setMetadataTo(packet);
+    return art_net::art_sync::PACKET_SIZE;
+}
+
+size_t makeArtTimeCode()
+{
+    art_net::art_timecode::setDataTo(packet, ArtTimeCodeMetadata {1, 2, 3, 4, ArtTimeCodeType::EBU, 0});
+    return art_net::art_timecode::PACKET_SIZE;
+}
+
+size_t makeArtTrigger()
+{
+    art_net::art_trigger::setDataTo(packet, 0xFFFF, 1, 2, nullptr, 0);
+    return art_net::art_trigger::PAYLOAD;
+}
+
+void benchParse(std::vector<bench::Measurement> &results, double min_seconds)
+{
+    struct Case
+    {
+        const char *name;
+        size_t (*make)();
+    };
+    const Case cases[] = {
+        {"dmx", [] { return makeArtDmx(1); }},
+        {"dmx_unsubscribed", [] { return makeArtDmx(2); }},
+        {"nzs", [] { return makeArtNzs(1); }},
+        {"poll", makeArtPoll},
+        {"sync", makeArtSync},
+        {"trigger", makeArtTrigger},
+        {"timecode", makeArtTimeCode},
+        {"bad_id", [] {
+             const size_t size = makeArtDmx(1);
+             packet[0] = 'X';
+             return size;
+         }},
+    };
+    for (const auto &c : cases) {
+        Receiver receiver;
+        receiver.begin();
+        receiver.subscribeArtDmxUniverse(1, noop);
+        receiver.subscribeArtNzsUniverse(1, noopNzs);
+        receiver.subscribeArtSync([](const ArtNetRemoteInfo &) { sink = 1; });
+        receiver.subscribeArtTrigger([](const ArtTriggerMetadata &metadata, const ArtNetRemoteInfo &) { sink = metadata.key; });
+        receiver.subscribeArtTimeCode([](const ArtTimeCodeMetadata &metadata, const ArtNetRemoteInfo &) { sink = metadata.frames; });
+        const size_t size = c.make();
+        receiver.stream.setPacket(packet, size);
+        results.push_back(bench::measure("parse", c.name, 0, [&] { receiver.parse(); }, min_seconds));
+    }
+}
+
+// dispatch cost of ArtDmx vs the number of subscribed universes
+void benchDispatch(std::vector<bench::Measurement> &results, double min_seconds)
+{
+    for (uint16_t num_universes : {1, 16, 64, 256, 1024, 4096}) {
+        Receiver receiver;
+        receiver.begin();
+        for (uint16_t u = 0; u < num_universes; ++u) {
+            receiver.subscribeArtDmxUniverse(u, noop);
+        }
+        receiver.stream.setPacket(packet, makeArtDmx(num_universes / 2));
+        results.push_back(bench::measure("dispatch", "dmx_universes", num_universes, [&] { receiver.parse(); }, min_seconds));
+    }
+}
+
+void benchPollReply(std::vector<bench::Measurement> &results, double min_seconds)
+{
+    const IPAddress ip(192, 168, 0, 201);
+    const uint8_t mac[6] {0, 1, 2, 3, 4, 5};
+    ArtPollReplyConfig config;
+    uint16_t universe = 0;
+    results.push_back(bench::measure("poll_reply", "generate_packet", 0, [&] {
+        const art_net::art_poll_reply::Packet reply = art_net::art_poll_reply::generatePacketFrom(ip, mac, universe++, config);
+        sink = reply.b[0];
+    }, min_seconds));
+}
+
+// send cost per packet vs the number of destinations (cycled)
+void benchSend(std::vector<bench::Measurement> &results, double min_seconds)
+{
+    uint8_t data[512] {};
+    for (uint16_t num_destinations : {1, 16, 64, 256, 1024}) {
+        std::vector<String> ips;
+        for (uint16_t i = 0; i < num_destinations; ++i) {
+            ips.push_back(String("10.0.") + String(i / 256) + "." + String(i % 256));
+        }
+        {
+            Sender sender;
+            sender.begin();
+            size_t i = 0;
+            results.push_back(bench::measure("send", "send_art_dmx", num_destinations, [&] {
+                sender.sendArtDmx(ips[i], 1, data, sizeof(data));
+                i = (i + 1) % ips.size();
+            }, min_seconds));
+        }
+        {
+            // mostly the lookup of the destination because of the streaming interval
+            Sender sender;
+            sender.begin();
+            sender.setArtDmxData(data, sizeof(data));
+            size_t i = 0;
+            results.push_back(bench::measure("send", "stream_art_dmx_to", num_destinations, [&] {
+                sender.streamArtDmxTo(ips[i], 1);
+                i = (i + 1) % ips.size();
+            }, min_seconds));
+        }
+    }
+}
+
+void benchFastLED(std::vector<bench::Measurement> &results, double min_seconds)
+{
+    static CRGB leds[170];
+    Receiver receiver;
+    receiver.begin();
+    receiver.forwardArtDmxDataToFastLED(1, leds, 170);
+    receiver.stream.setPacket(packet, makeArtDmx(1));
+    results.push_back(bench::measure("fastled", "forward_170_leds", 170, [&] { receiver.parse(); }, min_seconds));
+}
+
+void benchFastLEDMap(std::vector<bench::Measurement> &results, double min_seconds)
+{
+    // 680 LEDs over universes 1 - 4, and the strip gets ready on every 4th packet
+    static CRGB leds[680];
+    static uint8_t packets[4][art_net::PACKET_SIZE];
+    size_t size = 0;
+    for (uint16_t u = 0; u < 4; ++u) {
+        size = makeArtDmx(1 + u);
+        memcpy(packets[u], packet, size);
+    }
+    ArtDmxFastLEDMap strip(leds, 680, 1);
+    strip.onReady([] { ++sink; });
+    Receiver receiver;
+    receiver.begin();
+    receiver.forwardArtDmxDataToFastLED(strip);
+    ArtNetRemoteInfo remote {};
+    size_t i = 0;
+    results.push_back(bench::measure("fastled", "map_680_leds_per_universe", 170, [&] {
+        receiver.parse(packets[i], size, remote);
+        i = (i + 1) % 4;
+    }, min_seconds));
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const char *path = argc > 1 ? argv[1] : nullptr;
+    const double min_seconds = argc > 2 ? std::atof(argv[2]) : 0.2;
+
+    std::vector<bench::Measurement> results;
+    benchParse(results, min_seconds);
+    benchDispatch(results, min_seconds);
+    benchPollReply(results, min_seconds);
+    benchSend(results, min_seconds);
+    benchFastLED(results, min_seconds);
+    benchFastLEDMap(results, min_seconds);
+
+    if (path) {
+        FILE *fp = std::fopen(path, "w");
+        if (!fp) {
+            std::fprintf(stderr, "failed to open %s\n", path);
+            return 1;
+        }
+        bench::printJson(fp, ARTNET_HOST_VERSION, results);
+        std::fclose(fp);
+    }
+    bench::printJson(stdout, ARTNET_HOST_VERSION, results);
+    return 0;
+}
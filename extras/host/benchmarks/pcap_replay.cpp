@@ -0,0 +1,189 @@
+// Replay Art-Net traffic captured from real shows (.pcap) through Receiver_::parse(data, size, remote)
+// All ArtDmx / ArtNzs universes in the capture are subscribed first, then the UDP datagrams to the Art-Net port
+// are dispatched as fast as possible, or at the captured timing (scaled by speed).
+// Prints packets per second, dispatch latency and frames per universe.
+//
+// usage: pcap_replay <capture.pcap> [fast|realtime] [speed=1.0] [port=6454]
+
+#include "BenchUtil.h"
+#include "StubUDP.h"
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <thread>
+
+namespace {
+
+struct UniverseFrames
+{
+    uint64_t dmx {0};
+    uint64_t nzs {0};
+};
+
+bool isArtNet(const art_net::host::PcapDatagram &d, uint16_t port)
+{
+    return d.dst_port == port && d.size >= 10 && memcmp(d.payload, art_net::ARTNET_ID, sizeof(art_net::ARTNET_ID)) == 0;
+}
+
+uint16_t opCodeOf(const uint8_t *payload)
+{
+    return static_cast<uint16_t>((payload[art_net::art_dmx::OP_CODE_H] << 8) | payload[art_net::art_dmx::OP_CODE_L]);
+}
+
+const char *nameOf(art_net::OpCode op)
+{
+    switch (op) {
+        case art_net::OpCode::Dmx: return "ArtDmx";
+        case art_net::OpCode::Nzs: return "ArtNzs";
+        case art_net::OpCode::Poll: return "ArtPoll";
+        case art_net::OpCode::PollReply: return "ArtPollReply";
+        case art_net::OpCode::Sync: return "ArtSync";
+        case art_net::OpCode::Trigger: return "ArtTrigger";
+        case art_net::OpCode::TimeCode: return "ArtTimeCode";
+        case art_net::OpCode::Filtered: return "(filtered)";
+        case art_net::OpCode::Unsupported: return "(unsupported)";
+        case art_net::OpCode::ParseFailed: return "(parse failed)";
+        default: return "(other)";
+    }
+}
+
+uint32_t percentile(std::vector<uint32_t> &samples, double p)
+{
+    if (samples.empty()) {
+        return 0;
+    }
+    const size_t i = std::min(samples.size() - 1, static_cast<size_t>(p * static_cast<double>(samples.size())));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(i), samples.end());
+    return samples[i];
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <capture.pcap> [fast|realtime] [speed=1.0] [port=6454]\n", argv[0]);
+        return 1;
+    }
+    const char *path = argv[1];
+    const bool realtime = argc > 2 && strcmp(argv[2], "realtime") == 0;
+    const double speed = argc > 3 ? atof(argv[3]) : 1.0;
+    const uint16_t port = static_cast<uint16_t>(argc > 4 ? atoi(argv[4]) : art_net::DEFAULT_PORT);
+    if (speed <= 0.0) {
+        fprintf(stderr, "speed should be > 0\n");
+        return 1;
+    }
+
+    art_net::host::PcapReader reader;
+    if (!reader.open(path)) {
+        fprintf(stderr, "failed to open %s (classic pcap with Ethernet / raw IP / SLL link type is supported)\n", path);
+        return 1;
+    }
+
+    // 1st pass: find the universes to subscribe
+    std::map<uint16_t, UniverseFrames> universes;
+    art_net::host::PcapDatagram d;
+    uint64_t first_us = 0, last_us = 0, num_artnet = 0;
+    while (reader.next(d)) {
+        if (!isArtNet(d, port)) {
+            continue;
+        }
+        if (num_artnet++ == 0) {
+            first_us = d.timestamp_us;
+        }
+        last_us = d.timestamp_us;
+        const uint16_t op = opCodeOf(d.payload);
+        if ((op == static_cast<uint16_t>(art_net::OpCode::Dmx) || op == static_cast<uint16_t>(art_net::OpCode::Nzs)) && d.size > art_net::art_dmx::SUBUNI) {
+            universes[static_cast<uint16_t>((d.payload[art_net::art_dmx::NET] << 8) | d.payload[art_net::art_dmx::SUBUNI])];
+        }
+    }
+    if (num_artnet == 0) {
+        fprintf(stderr, "no Art-Net packets to port %u in %s\n", port, path);
+        return 1;
+    }
+    if (universes.size() > bench::MAX_UNIVERSES) {
+        fprintf(stderr, "warning: %zu universes in the capture, only %zu are subscribed\n", universes.size(), bench::MAX_UNIVERSES);
+    }
+
+    // ArtPollReply is sent to StubUDP and discarded
+    bench::Receiver<StubUDP> receiver;
+    receiver.begin();
+    size_t num_subscribed = 0;
+    for (auto &u : universes) {
+        if (num_subscribed++ >= bench::MAX_UNIVERSES) {
+            break;
+        }
+        UniverseFrames *frames = &u.second;
+        receiver.subscribeArtDmxUniverse(u.first, [frames](const uint8_t *, uint16_t, const ArtDmxMetadata &, const ArtNetRemoteInfo &) {
+            ++frames->dmx;
+        });
+        receiver.subscribeArtNzsUniverse(u.first, [frames](const uint8_t *, uint16_t, const ArtNzsMetadata &, const ArtNetRemoteInfo &) {
+            ++frames->nzs;
+        });
+    }
+    receiver.subscribeArtSync([](const ArtNetRemoteInfo &) {});
+    receiver.subscribeArtTrigger([](const ArtTriggerMetadata &, const ArtNetRemoteInfo &) {});
+    receiver.subscribeArtTimeCode([](const ArtTimeCodeMetadata &, const ArtNetRemoteInfo &) {});
+
+    // 2nd pass: replay
+    reader.rewind();
+    std::vector<uint32_t> latency_ns;
+    latency_ns.reserve(static_cast<size_t>(num_artnet));
+    std::map<art_net::OpCode, uint64_t> results;
+    uint64_t dispatch_ns = 0;
+    uint64_t max_lateness_us = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (reader.next(d)) {
+        if (!isArtNet(d, port)) {
+            continue;
+        }
+        if (realtime) {
+            const auto due = start + std::chrono::microseconds(static_cast<uint64_t>(static_cast<double>(d.timestamp_us - first_us) / speed));
+            const auto now = std::chrono::steady_clock::now();
+            if (now < due) {
+                std::this_thread::sleep_until(due);
+            } else {
+                const uint64_t late = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - due).count());
+                max_lateness_us = std::max(max_lateness_us, late);
+            }
+        }
+        const ArtNetRemoteInfo remote {d.src_ip, d.src_port, 0};
+        const auto t0 = std::chrono::steady_clock::now();
+        const art_net::OpCode op = receiver.parse(d.payload, d.size, remote);
+        const auto t1 = std::chrono::steady_clock::now();
+        const uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        dispatch_ns += ns;
+        latency_ns.push_back(static_cast<uint32_t>(std::min<uint64_t>(ns, UINT32_MAX)));
+        ++results[op];
+    }
+    const double wall = bench::secondsSince(start);
+    const double captured = static_cast<double>(last_us - first_us) / 1e6;
+
+    printf("capture   : %s (%.3f s, %llu Art-Net packets, %zu universes)\n", path, captured, static_cast<unsigned long long>(num_artnet), universes.size());
+    printf("mode      : %s", realtime ? "realtime" : "fast");
+    if (realtime) {
+        printf(" (speed %.2fx, max lateness %llu us)", speed, static_cast<unsigned long long>(max_lateness_us));
+    }
+    printf("\nwall time : %.3f s\n", wall);
+    printf("replay    : %.0f packets/s\n", wall > 0.0 ? static_cast<double>(num_artnet) / wall : 0.0);
+    printf("dispatch  : %.0f packets/s (time in parse() only)\n", dispatch_ns ? static_cast<double>(num_artnet) * 1e9 / static_cast<double>(dispatch_ns) : 0.0);
+    const double mean = latency_ns.empty() ? 0.0 : static_cast<double>(dispatch_ns) / static_cast<double>(latency_ns.size());
+    const uint32_t p50 = percentile(latency_ns, 0.50);
+    const uint32_t p99 = percentile(latency_ns, 0.99);
+    const uint32_t p999 = percentile(latency_ns, 0.999);
+    const uint32_t max = latency_ns.empty() ? 0 : *std::max_element(latency_ns.begin(), latency_ns.end());
+    printf("latency   : mean %.0f ns, p50 %u ns, p99 %u ns, p99.9 %u ns, max %u ns\n", mean, p50, p99, p999, max);
+
+    printf("\n%-16s %12s\n", "result", "packets");
+    for (const auto &r : results) {
+        printf("%-16s %12llu\n", nameOf(r.first), static_cast<unsigned long long>(r.second));
+    }
+
+    printf("\n%-10s %12s %12s %10s\n", "universe", "ArtDmx", "ArtNzs", "fps");
+    for (const auto &u : universes) {
+        const uint64_t frames = u.second.dmx + u.second.nzs;
+        printf("%-10u %12llu %12llu %10.1f\n", u.first, static_cast<unsigned long long>(u.second.dmx),
+            static_cast<unsigned long long>(u.second.nzs), captured > 0.0 ? static_cast<double>(frames) / captured : 0.0);
+    }
+    return 0;
+}
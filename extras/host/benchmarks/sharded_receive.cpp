@@ -0,0 +1,118 @@
+// Scaling of ShardedReceiver from 1 to N workers over loopback.
+// Sender threads (each has its own source port, so that SO_REUSEPORT distributes them) send disjoint sets of
+// universes as fast as possible. The receiver counts dispatched packets and checks the per-universe ordering
+// by the ArtDmx sequence (drops make gaps, but a sequence must never go backwards).
+//
+// usage: sharded_receive [max_workers=hardware_concurrency] [universes=2048] [senders=4] [seconds=2]
+
+#include "BenchUtil.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Result
+{
+    double seconds;
+    uint64_t sent;
+    uint64_t dispatched;
+    uint64_t reordered;
+    uint64_t ring_drops;
+};
+
+Result run(size_t num_workers, uint16_t num_universes, size_t num_senders, double seconds)
+{
+    art_net::host::ShardedReceiver<bench::MAX_UNIVERSES> receiver(num_workers);
+
+    // each universe is only touched by its worker thread
+    std::vector<uint64_t> dispatched(num_universes, 0);
+    std::vector<uint64_t> reordered(num_universes, 0);
+    std::vector<int> last_sequence(num_universes, -1);
+    for (uint16_t u = 0; u < num_universes; ++u) {
+        receiver.subscribeArtDmxUniverse(u, [&, u](const uint8_t *, uint16_t, const ArtDmxMetadata &metadata, const ArtNetRemoteInfo &) {
+            // going backwards within half of the 8 bit range means the packets were reordered
+            const int last = last_sequence[u];
+            if (last >= 0 && static_cast<uint8_t>(metadata.sequence - last) > 128) {
+                ++reordered[u];
+            }
+            last_sequence[u] = metadata.sequence;
+            ++dispatched[u];
+        });
+    }
+    if (!receiver.begin()) {
+        fprintf(stderr, "failed to open sockets\n");
+        exit(1);
+    }
+
+    std::atomic<bool> running {true};
+    std::vector<uint64_t> sent(num_senders, 0);
+    std::vector<std::thread> senders;
+    for (size_t i = 0; i < num_senders; ++i) {
+        senders.emplace_back([&, i] {
+            bench::Sender<PosixUDPBatch> sender;
+            sender.begin();
+            const String ip = "127.0.0.1";
+            uint8_t data[512] {};
+            while (running) {
+                sender.beginFrame();
+                for (uint16_t u = static_cast<uint16_t>(i); u < num_universes; u = static_cast<uint16_t>(u + num_senders)) {
+                    sender.sendArtDmx(ip, u, data, sizeof(data));
+                }
+                sender.endFrame();
+            }
+            sent[i] = sender.stream.stats().tx_datagrams;
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    delay(static_cast<uint32_t>(seconds * 1000));
+    running = false;
+    for (auto &t : senders) {
+        t.join();
+    }
+    const double elapsed = bench::secondsSince(start);
+    delay(100);
+    receiver.end();
+
+    Result result {elapsed, 0, 0, 0, 0};
+    for (size_t i = 0; i < num_senders; ++i) {
+        result.sent += sent[i];
+    }
+    for (uint16_t u = 0; u < num_universes; ++u) {
+        result.dispatched += dispatched[u];
+        result.reordered += reordered[u];
+    }
+    for (size_t w = 0; w < num_workers; ++w) {
+        result.ring_drops += receiver.stats(w).ring_drops;
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const size_t max_workers = argc > 1 ? static_cast<size_t>(atoi(argv[1])) : std::max(1u, std::thread::hardware_concurrency());
+    const uint16_t num_universes = static_cast<uint16_t>(argc > 2 ? atoi(argv[2]) : 2048);
+    const size_t num_senders = argc > 3 ? static_cast<size_t>(atoi(argv[3])) : 4;
+    const double seconds = argc > 4 ? atof(argv[4]) : 2.0;
+    if (max_workers == 0 || num_senders == 0 || num_universes == 0 || num_universes > bench::MAX_UNIVERSES) {
+        fprintf(stderr, "usage: sharded_receive [max_workers] [universes <= %zu] [senders] [seconds]\n", bench::MAX_UNIVERSES);
+        return 1;
+    }
+
+    printf("cores: %u, universes: %u, senders: %zu, duration: %.1f s\n", std::thread::hardware_concurrency(), num_universes, num_senders, seconds);
+    printf("%-8s %12s %12s %10s %10s %10s\n", "workers", "sent pkt/s", "rx pkt/s", "loss %", "ring drop", "reordered");
+    for (size_t workers = 1; workers <= max_workers; ++workers) {
+        const Result r = run(workers, num_universes, num_senders, seconds);
+        printf("%-8zu %12.0f %12.0f %10.2f %10llu %10llu\n",
+            workers,
+            r.sent / r.seconds,
+            r.dispatched / r.seconds,
+            r.sent ? 100.0 * (1.0 - static_cast<double>(r.dispatched) / r.sent) : 0.0,
+            static_cast<unsigned long long>(r.ring_drops),
+            static_cast<unsigned long long>(r.reordered));
+    }
+    return 0;
+}
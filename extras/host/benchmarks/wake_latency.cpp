@@ -0,0 +1,107 @@
+// Wake-to-dispatch latency and CPU usage of the receive loop: busy polling, polling with delay(1), and EventLoop (epoll).
+// The sender sends one ArtDmx packet every interval with the send time in the payload,
+// and the receiver measures the time from send to the callback, and the CPU time of the receive thread.
+//
+// usage: wake_latency [packets=500] [interval_us=2000]
+
+#include "BenchUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <time.h>
+
+namespace {
+
+enum class Mode { Busy, Delay, EventLoop };
+
+uint64_t nowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+double threadCpuSeconds()
+{
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+struct Result
+{
+    std::vector<double> latency_us;
+    double cpu_percent;
+};
+
+Result run(Mode mode, size_t num_packets, uint32_t interval_us)
+{
+    bench::Receiver<PosixUDPBatch> receiver;
+    receiver.begin();
+    Result result;
+    result.latency_us.reserve(num_packets);
+    receiver.subscribeArtDmxUniverse(1, [&](const uint8_t *data, uint16_t, const ArtDmxMetadata &, const ArtNetRemoteInfo &) {
+        uint64_t sent_ns;
+        memcpy(&sent_ns, data, sizeof(sent_ns));
+        result.latency_us.push_back((nowNs() - sent_ns) * 1e-3);
+    });
+
+    std::atomic<bool> running {true};
+    art_net::host::EventLoop loop;
+    loop.add(receiver);
+    double cpu_seconds = 0;
+    const auto start = std::chrono::steady_clock::now();
+    std::thread rx_thread([&] {
+        const double cpu_start = threadCpuSeconds();
+        if (mode == Mode::EventLoop) {
+            loop.run();
+        } else {
+            while (running) {
+                if (receiver.parse() == art_net::OpCode::NoPacket && mode == Mode::Delay) {
+                    delay(1);
+                }
+            }
+        }
+        cpu_seconds = threadCpuSeconds() - cpu_start;
+    });
+
+    bench::Sender<PosixUDP> sender;
+    sender.begin();
+    uint8_t data[512] {};
+    for (size_t i = 0; i < num_packets; ++i) {
+        delayMicroseconds(interval_us);
+        const uint64_t sent_ns = nowNs();
+        memcpy(data, &sent_ns, sizeof(sent_ns));
+        sender.sendArtDmx("127.0.0.1", 1, data, sizeof(data));
+    }
+    delay(10);
+
+    running = false;
+    loop.stop();
+    rx_thread.join();
+    result.cpu_percent = 100.0 * cpu_seconds / bench::secondsSince(start);
+    return result;
+}
+
+void print(const char *name, Result r)
+{
+    std::sort(r.latency_us.begin(), r.latency_us.end());
+    const auto percentile = [&](double p) {
+        return r.latency_us.empty() ? 0.0 : r.latency_us[static_cast<size_t>(p * (r.latency_us.size() - 1))];
+    };
+    printf("%-10s %8zu %10.1f %10.1f %10.1f %10.1f\n", name, r.latency_us.size(), percentile(0.5), percentile(0.99), percentile(1.0), r.cpu_percent);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const size_t num_packets = argc > 1 ? static_cast<size_t>(atoi(argv[1])) : 500;
+    const uint32_t interval_us = argc > 2 ? static_cast<uint32_t>(atoi(argv[2])) : 2000;
+
+    printf("packets: %zu, interval: %u us\n", num_packets, interval_us);
+    printf("%-10s %8s %10s %10s %10s %10s\n", "mode", "received", "p50 us", "p99 us", "max us", "cpu %");
+    print("busy", run(Mode::Busy, num_packets, interval_us));
+    print("delay(1)", run(Mode::Delay, num_packets, interval_us));
+    print("epoll", run(Mode::EventLoop, num_packets, interval_us));
+    return 0;
+}
@@ -0,0 +1,48 @@
+#!/bin/sh
+# Run the host examples and benchmarks briefly over the loopback interface (CI)
+#
+#   sh extras/host/ci/smoke.sh build
+set -eu
+
+BUILD=${1:-build}
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+# run a command which normally never returns for a while (exit code 124 of timeout is success)
+run_for() {
+    seconds=$1
+    shift
+    timeout "$seconds" "$@" || [ $? -eq 124 ]
+}
+
+echo "== receivers"
+run_for 2 "$BUILD/receiver"
+run_for 2 "$BUILD/receiver_epoll"
+
+echo "== capture and replay"
+"$BUILD/receiver_capture" 2 "$OUT/capture.pcap" &
+capture=$!
+run_for 3 "$BUILD/sender" 127.0.0.1
+wait $capture
+"$BUILD/pcap_replay" "$OUT/capture.pcap"
+
+echo "== trace"
+"$BUILD/receiver_trace" 2 "$OUT/trace.json" &
+trace=$!
+run_for 3 "$BUILD/sender" 127.0.0.1
+wait $trace
+test -s "$OUT/trace.json"
+
+echo "== show record and playback"
+"$BUILD/show_record" 2 "$OUT/test.show" &
+record=$!
+run_for 3 "$BUILD/sender" 127.0.0.1
+wait $record
+"$BUILD/show_play" "$OUT/test.show" 127.0.0.1 4
+
+echo "== benchmarks"
+"$BUILD/micro" "$OUT/micro.json" 0.01
+"$BUILD/loopback_stress" 256 44 2
+"$BUILD/batch_io" 64 0.5
+"$BUILD/sharded_receive" 2 256 2 0.5
+"$BUILD/wake_latency" 50 2000
@@ -0,0 +1,52 @@
+#include <ArtnetLinux.h>
+
+// usage: receiver [interface]
+int main(int argc, char **argv)
+{
+    if (argc > 1) {
+        PosixNetwork.setInterface(argv[1]);
+    }
+
+    ArtnetLinuxReceiver artnet;
+    uint16_t universe1 = 1;  // 0 - 32767
+    uint8_t universe2 = 2;   // 0 - 15
+
+    if (!PosixNetwork.isReady()) {
+        Serial.println("network interface is not ready");
+    }
+    artnet.begin();
+
+    // if Artnet packet comes to this universe, this function (lambda) is called
+    artnet.subscribeArtDmxUniverse(universe1, [&](const uint8_t *data, uint16_t size, const ArtDmxMetadata &metadata, const ArtNetRemoteInfo &remote) {
+        Serial.print("lambda : artnet data from ");
+        Serial.print(remote.ip);
+        Serial.print(":");
+        Serial.print(remote.port);
+        Serial.print(", universe = ");
+        Serial.print(universe1);
+        Serial.print(", size = ");
+        Serial.print(size);
+        Serial.print(") :");
+        for (size_t i = 0; i < size; ++i) {
+            Serial.print(data[i]);
+            Serial.print(",");
+        }
+        Serial.println();
+    });
+
+    artnet.subscribeArtDmxUniverse(universe2, [&](const uint8_t *data, uint16_t size, const ArtDmxMetadata &metadata, const ArtNetRemoteInfo &remote) {
+        Serial.print("universe = ");
+        Serial.print(universe2);
+        Serial.print(", sequence = ");
+        Serial.print(metadata.sequence);
+        Serial.print(", size = ");
+        Serial.println(size);
+    });
+
+    while (true) {
+        // check if artnet packet has come and execute callback
+        if (artnet.parse() == art_net::OpCode::NoPacket) {
+            delay(1);
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#include <ArtnetLinux.h>
+#include <cstdlib>
+
+// Capture the received datagrams (and sent ArtPollReply) into a pcap file (open with Wireshark, or replay by pcap_replay)
+// The receiver only copies datagrams into the ring, and PcapCaptureWriter writes them to the file on its own thread.
+// usage: receiver_capture [seconds] [output.pcap]
+int main(int argc, char **argv)
+{
+    const uint32_t seconds = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 10;
+    const char *path = argc > 2 ? argv[2] : "artnet_capture.pcap";
+
+    static art_net::CaptureRing<1 << 20> ring;  // 1 MB (about 1900 ArtDmx packets)
+    art_net::host::PcapCaptureWriter<decltype(ring)> writer;
+    if (!writer.start(ring, path, PosixNetwork.localIP())) {
+        Serial.print("failed to open ");
+        Serial.println(path);
+        return 1;
+    }
+
+    ArtnetLinux artnet;
+    artnet.begin();
+    artnet.setCaptureSink(&ring);
+    artnet.subscribeArtDmx([](const uint8_t *data, uint16_t size, const ArtDmxMetadata &metadata, const ArtNetRemoteInfo &remote) {});
+
+    Serial.print("capturing for ");
+    Serial.print(seconds);
+    Serial.println(" sec...");
+    const uint32_t start_ms = millis();
+    while (millis() - start_ms < seconds * 1000) {
+        if (artnet.parse() == art_net::OpCode::NoPacket) {
+            delay(1);
+        }
+    }
+    artnet.setCaptureSink(nullptr);
+    writer.stop();
+
+    Serial.print(static_cast<unsigned long>(writer.written()));
+    Serial.print(" datagrams are written to ");
+    Serial.print(path);
+    Serial.print(" (dropped: ");
+    Serial.print(ring.dropped());
+    Serial.println(")");
+    return 0;
+}
@@ -0,0 +1,31 @@
+#include <ArtnetLinux.h>
+
+// Receiver which sleeps until datagrams arrive instead of polling parse()
+// usage: receiver_epoll [interface]
+int main(int argc, char **argv)
+{
+    if (argc > 1) {
+        PosixNetwork.setInterface(argv[1]);
+    }
+
+    ArtnetLinuxBatchReceiver artnet;
+    artnet.begin();
+
+    artnet.subscribeArtDmx([](const uint8_t *data, uint16_t size, const ArtDmxMetadata &metadata, const ArtNetRemoteInfo &remote) {
+        Serial.print("artnet data from ");
+        Serial.print(remote.ip);
+        Serial.print(", net = ");
+        Serial.print(metadata.net);
+        Serial.print(", subnet = ");
+        Serial.print(metadata.subnet);
+        Serial.print(", universe = ");
+        Serial.print(metadata.universe);
+        Serial.print(", size = ");
+        Serial.println(size);
+    });
+
+    // wait for datagrams and scheduled ArtPollReply with epoll
+    art_net::host::EventLoop loop;
+    loop.add(artnet);
+    loop.run();
+}
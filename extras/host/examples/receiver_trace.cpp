@@ -0,0 +1,41 @@
+#define ARTNET_ENABLE_TRACE 1
+#include <ArtnetLinux.h>
+#include <cstdlib>
+
+// Record the trace points of the receive path and write them as Chrome trace JSON
+// (open the file with chrome://tracing or https://ui.perfetto.dev)
+// usage: receiver_trace [seconds] [output.json]
+int main(int argc, char **argv)
+{
+    const uint32_t seconds = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 5;
+    const char *path = argc > 2 ? argv[2] : "artnet_trace.json";
+
+    ArtnetLinux artnet;
+    artnet.begin();
+
+    // slow renderer to see in the trace
+    artnet.subscribeArtDmx([](const uint8_t *data, uint16_t size, const ArtDmxMetadata &metadata, const ArtNetRemoteInfo &remote) {
+        delayMicroseconds(100);
+    });
+
+    Serial.print("tracing for ");
+    Serial.print(seconds);
+    Serial.println(" sec...");
+    const uint32_t start_ms = millis();
+    while (millis() - start_ms < seconds * 1000) {
+        if (artnet.parse() == art_net::OpCode::NoPacket) {
+            delay(1);
+        }
+    }
+
+    const int n = art_net::host::writeChromeTrace(path);
+    if (n < 0) {
+        Serial.print("failed to open ");
+        Serial.println(path);
+        return 1;
+    }
+    Serial.print(n);
+    Serial.print(" records are written to ");
+    Serial.println(path);
+    return 0;
+}
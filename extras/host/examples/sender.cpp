@@ -0,0 +1,25 @@
+#include <ArtnetLinux.h>
+
+// usage: sender [target_ip]
+int main(int argc, char **argv)
+{
+    const String target_ip = argc > 1 ? argv[1] : "127.0.0.1";
+    uint8_t universe = 1;  // 0 - 15
+
+    ArtnetLinuxSender artnet;
+    // bind any free local port so that a receiver on the same host can use the Art-Net port
+    artnet.begin(0);
+
+    uint8_t data[512];
+    uint8_t value = 0;
+
+    while (true) {
+        memset(data, value++, sizeof(data));
+
+        // change send data as you want
+        artnet.setArtDmxData(data, sizeof(data));
+        artnet.streamArtDmxTo(target_ip, universe);  // automatically send set data in 40fps
+
+        delay(1);
+    }
+}
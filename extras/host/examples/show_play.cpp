@@ -0,0 +1,52 @@
+#include <ArtnetLinux.h>
+#include <cstdlib>
+#include <thread>
+
+// Play a show file recorded by show_record at the recorded timing
+// usage: show_play <input.show> [target_ip] [speed] [start_sec] [loop]
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        Serial.println("usage: show_play <input.show> [target_ip] [speed] [start_sec] [loop]");
+        return 1;
+    }
+    const char *path = argv[1];
+    const String target_ip = argc > 2 ? argv[2] : "127.0.0.1";
+    const double speed = argc > 3 ? std::atof(argv[3]) : 1.0;
+    const double start_sec = argc > 4 ? std::atof(argv[4]) : 0.0;
+    const bool loop = argc > 5 && String(argv[5]) == "loop";
+
+    art_net::host::ShowPlayer player;
+    if (!player.open(path)) {
+        Serial.print("failed to open ");
+        Serial.println(path);
+        return 1;
+    }
+    player.setDestination(target_ip);
+    player.setSpeed(speed);
+    player.setLoop(loop);
+
+    ArtnetLinuxSender artnet;
+    // bind any free local port so that a receiver on the same host can use the Art-Net port
+    artnet.begin(0);
+
+    Serial.print("playing ");
+    Serial.print(path);
+    Serial.print(" (");
+    Serial.print(static_cast<double>(player.durationUs()) / 1e6);
+    Serial.println(" sec)");
+    if (start_sec > 0.0) {
+        player.seek(static_cast<uint64_t>(start_sec * 1e6));
+    }
+    player.play();
+    while (player.isPlaying()) {
+        player.update(artnet);
+        // sleep until the next frame (at most 1 ms to keep the timing of the frames close)
+        const uint32_t wait_us = player.nextDueUs();
+        if (wait_us > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(wait_us < 1000 ? wait_us : 1000));
+        }
+    }
+    Serial.println("finished");
+    return 0;
+}
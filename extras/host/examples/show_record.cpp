@@ -0,0 +1,41 @@
+#include <ArtnetLinux.h>
+#include <cstdlib>
+
+// Record ArtDmx / ArtSync from a console into a show file (play it by show_play)
+// usage: show_record [seconds] [output.show] [key_frame_interval_ms]
+int main(int argc, char **argv)
+{
+    const uint32_t seconds = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 10;
+    const char *path = argc > 2 ? argv[2] : "artnet.show";
+    const uint32_t key_frame_interval_ms = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 1000;
+
+    art_net::host::ShowRecorder recorder;
+    if (!recorder.open(path, key_frame_interval_ms)) {
+        Serial.print("failed to open ");
+        Serial.println(path);
+        return 1;
+    }
+
+    ArtnetLinuxReceiver artnet;
+    artnet.begin();
+    recorder.subscribe(artnet);
+
+    Serial.print("recording for ");
+    Serial.print(seconds);
+    Serial.println(" sec...");
+    const uint32_t start_ms = millis();
+    while (millis() - start_ms < seconds * 1000) {
+        if (artnet.parse() == art_net::OpCode::NoPacket) {
+            delay(1);
+        }
+    }
+    artnet.unsubscribeArtDmx();
+    recorder.close();
+
+    Serial.print(static_cast<unsigned long>(recorder.records()));
+    Serial.print(" records (");
+    Serial.print(static_cast<unsigned long>(recorder.bytesWritten()));
+    Serial.print(" bytes) are written to ");
+    Serial.println(path);
+    return recorder.hasError() ? 1 : 0;
+}
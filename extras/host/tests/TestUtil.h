@@ -0,0 +1,71 @@
+#pragma once
+#ifndef ARTNET_HOST_TEST_UTIL_H
+#define ARTNET_HOST_TEST_UTIL_H
+
+// Minimal checks for the host tests (no test framework, each test is one executable run by ctest)
+// CHECK() prints the failed expression and continues, and test::result() is the exit code of main().
+
+#include <ArtnetLinux.h>
+#include <cstdio>
+
+namespace test {
+
+inline int &failures()
+{
+    static int n = 0;
+    return n;
+}
+
+inline bool check(bool ok, const char *expr, const char *file, int line)
+{
+    if (!ok) {
+        ++failures();
+        fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expr);
+    }
+    return ok;
+}
+
+inline int result(const char *name)
+{
+    if (failures() > 0) {
+        fprintf(stderr, "%s: %d check(s) failed\n", name, failures());
+        return 1;
+    }
+    printf("%s: ok\n", name);
+    return 0;
+}
+
+// ArtDmx packet of the universe (15 bit) filled with value, returns the size of the datagram
+inline size_t makeArtDmx(uint8_t *packet, uint16_t universe, uint8_t sequence, uint8_t value, uint16_t size = 512)
+{
+    uint8_t data[512];
+    memset(data, value, sizeof(data));
+    art_net::art_dmx::setMetadataTo(packet, sequence, 0, static_cast<uint8_t>(universe >> 8), static_cast<uint8_t>((universe >> 4) & 0x0F), static_cast<uint8_t>(universe & 0x0F));
+    art_net::art_dmx::setDataTo(packet, data, size);
+    return art_net::HEADER_SIZE + size;
+}
+
+inline size_t makeArtSync(uint8_t *packet)
+{
+    art_net::art_sync::setMetadataTo(packet);
+    return art_net::art_sync::PACKET_SIZE;
+}
+
+inline uint16_t universeOf(const ArtDmxMetadata &metadata)
+{
+    return static_cast<uint16_t>((metadata.net << 8) | (metadata.subnet << 4) | metadata.universe);
+}
+
+// send a datagram from the endpoint
+inline void sendTo(LoopbackUDP &from, const IPAddress &ip, uint16_t port, const uint8_t *data, size_t size)
+{
+    from.beginPacket(ip, port);
+    from.write(data, size);
+    from.endPacket();
+}
+
+} // namespace test
+
+#define CHECK(expr) test::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+#endif // ARTNET_HOST_TEST_UTIL_H
@@ -0,0 +1,157 @@
+// CoalescingReceiver: only the newest packet of each universe and source is dispatched, in arrival order,
+// other packets keep their position, and the slots are rotated when more universes arrive than Slots
+
+#include "TestUtil.h"
+#include <Artnet/CoalescingReceiver.h>
+#include <vector>
+
+namespace {
+
+constexpr uint16_t SYNC {0xFFFF};
+
+struct Event
+{
+    uint16_t universe;  // SYNC for ArtSync
+    uint8_t sequence;
+    uint8_t value;
+};
+
+template <size_t Slots>
+struct Fixture
+{
+    art_net::CoalescingReceiver<LoopbackUDP, Slots> receiver;
+    LoopbackUDP controller;
+    uint16_t port;
+    std::vector<Event> events;
+    uint8_t packet[art_net::PACKET_SIZE];
+
+    explicit Fixture(uint16_t p)
+    : port(p)
+    {
+        this->receiver.begin(p);
+        this->controller.begin(0);
+        this->receiver.subscribeArtDmx([this](const uint8_t *data, uint16_t, const ArtDmxMetadata &metadata, const ArtNetRemoteInfo &) {
+            this->events.push_back(Event {test::universeOf(metadata), metadata.sequence, data[0]});
+        });
+        this->receiver.subscribeArtSync([this](const ArtNetRemoteInfo &) {
+            this->events.push_back(Event {SYNC, 0, 0});
+        });
+    }
+
+    // the payload is filled with the sequence to check that the dispatched data is from the same packet
+    void sendArtDmx(uint16_t universe, uint8_t sequence)
+    {
+        this->sendArtDmxFrom(this->controller, universe, sequence);
+    }
+    void sendArtDmxFrom(LoopbackUDP &from, uint16_t universe, uint8_t sequence)
+    {
+        const size_t size = test::makeArtDmx(this->packet, universe, sequence, sequence);
+        test::sendTo(from, art_net::host::LoopbackNetwork::broadcastIP(), this->port, this->packet, size);
+    }
+
+    void sendArtSync()
+    {
+        const size_t size = test::makeArtSync(this->packet);
+        test::sendTo(this->controller, art_net::host::LoopbackNetwork::broadcastIP(), this->port, this->packet, size);
+    }
+
+    bool matches(const std::vector<Event> &expected) const
+    {
+        if (this->events.size() != expected.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < expected.size(); ++i) {
+            const Event &e = this->events[i];
+            if (e.universe != expected[i].universe || e.sequence != expected[i].sequence || (e.universe != SYNC && e.value != e.sequence)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+void testNewestPerUniverse()
+{
+    Fixture<4> f(16454);
+    f.sendArtDmx(1, 1);
+    f.sendArtDmx(2, 1);
+    f.sendArtDmx(1, 2);
+    f.sendArtDmx(1, 3);
+    f.sendArtDmx(2, 2);
+    f.sendArtSync();
+    CHECK(f.receiver.drain() == 6);
+    // kept in the order of the first arrival, and ArtSync after the data of its frame
+    CHECK(f.matches({{1, 3, 0}, {2, 2, 0}, {SYNC, 0, 0}}));
+    CHECK(f.receiver.coalesced() == 3);
+    CHECK(f.receiver.drain() == 0);
+}
+
+void testSlotRotation()
+{
+    Fixture<2> f(16455);
+    // the third universe does not fit, so the kept packets are dispatched before it is kept
+    f.sendArtDmx(1, 1);
+    f.sendArtDmx(2, 1);
+    f.sendArtDmx(3, 1);
+    f.sendArtDmx(1, 2);
+    f.receiver.drain();
+    CHECK(f.matches({{1, 1, 0}, {2, 1, 0}, {3, 1, 0}, {1, 2, 0}}));
+    CHECK(f.receiver.coalesced() == 0);
+
+    // the rotated slots are reused without mixing the data of the packets
+    f.events.clear();
+    for (uint8_t seq = 3; seq < 40; ++seq) {
+        f.sendArtDmx(static_cast<uint16_t>(1 + seq % 3), seq);
+    }
+    f.receiver.drain();
+    bool consistent = !f.events.empty();
+    for (const Event &e : f.events) {
+        consistent &= e.value == e.sequence && e.universe == 1 + e.sequence % 3;
+    }
+    CHECK(consistent);
+    CHECK(f.events.back().sequence == 39);
+}
+
+void testReorderedSequence()
+{
+    Fixture<2> f(16456);
+    // an older sequence delivered late does not replace the newer one
+    f.sendArtDmx(1, 10);
+    f.sendArtDmx(1, 9);
+    f.receiver.drain();
+    CHECK(f.matches({{1, 10, 0}}));
+    CHECK(f.receiver.coalesced() == 1);
+
+    // sequence 0 (disabled) always replaces
+    f.events.clear();
+    f.sendArtDmx(1, 10);
+    f.sendArtDmx(1, 0);
+    f.receiver.drain();
+    CHECK(f.matches({{1, 0, 0}}));
+}
+
+void testSourcesKeptApart()
+{
+    Fixture<4> f(16460);
+    LoopbackUDP other;
+    other.begin(0);
+    // two consoles on the same universe (e.g. HTP merge): their sequences are unrelated, so neither replaces the other
+    f.sendArtDmx(1, 50);
+    f.sendArtDmxFrom(other, 1, 3);
+    f.sendArtDmx(1, 51);
+    f.sendArtDmxFrom(other, 1, 4);
+    f.receiver.drain();
+    CHECK(f.matches({{1, 51, 0}, {1, 4, 0}}));
+    CHECK(f.receiver.coalesced() == 2);
+}
+
+} // namespace
+
+int main()
+{
+    testNewestPerUniverse();
+    testSlotRotation();
+    testReorderedSequence();
+    testSourcesKeptApart();
+    return test::result("coalescing_receiver");
+}
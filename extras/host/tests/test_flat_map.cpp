@@ -0,0 +1,90 @@
+// FlatMap: sorted order, replacement, capacity, erase, and the zero capacity specialization
+
+#include "TestUtil.h"
+#include <string>
+
+namespace {
+
+using art_net::FlatMap;
+
+void testOrdering()
+{
+    FlatMap<uint16_t, int, 8> map;
+    const uint16_t keys[] = {42, 7, 300, 1, 99};
+    for (uint16_t k : keys) {
+        CHECK(map.insert(k, k * 10) != nullptr);
+    }
+    CHECK(map.size() == 5);
+    uint16_t prev = 0;
+    bool first = true;
+    for (const auto &e : map) {
+        CHECK(first || prev < e.first);
+        CHECK(e.second == e.first * 10);
+        prev = e.first;
+        first = false;
+    }
+    CHECK(map.begin()->first == 1);
+    CHECK((map.end() - 1)->first == 300);
+
+    // insert with an existing key replaces the value without changing the size
+    CHECK(map.insert(7, -1) != nullptr);
+    CHECK(map.size() == 5);
+    CHECK(*map.find(7) == -1);
+    CHECK(map.find(8) == nullptr);
+}
+
+void testCapacity()
+{
+    FlatMap<uint16_t, int, 3> map;
+    CHECK(map.capacity() == 3);
+    CHECK(map.insert(3, 3) && map.insert(1, 1) && map.insert(2, 2));
+    CHECK(map.full());
+    // a new key is rejected, but an existing key can still be replaced
+    CHECK(map.insert(4, 4) == nullptr);
+    CHECK(map.size() == 3);
+    CHECK(map.find(4) == nullptr);
+    CHECK(map.insert(2, 20) != nullptr);
+    CHECK(*map.find(2) == 20);
+}
+
+void testErase()
+{
+    FlatMap<uint16_t, std::string, 4> map;
+    map.insert(30, "thirty");
+    map.insert(10, "ten");
+    map.insert(20, "twenty");
+    CHECK(map.erase(10));
+    CHECK(!map.erase(10));
+    CHECK(map.size() == 2);
+    // values are moved when the entries are shifted
+    CHECK(map.begin()->first == 20 && map.begin()->second == "twenty");
+    CHECK(*map.find(30) == "thirty");
+    map.insert(5, "five");
+    CHECK(map.begin()->second == "five");
+    CHECK(*map.find(20) == "twenty");
+    map.clear();
+    CHECK(map.empty());
+    CHECK(map.find(20) == nullptr);
+}
+
+void testZeroCapacity()
+{
+    FlatMap<uint16_t, int, 0> map;
+    CHECK(map.capacity() == 0);
+    CHECK(map.empty() && map.full());
+    CHECK(map.insert(1, 1) == nullptr);
+    CHECK(map.find(1) == nullptr);
+    CHECK(!map.erase(1));
+    CHECK(map.begin() == map.end());
+}
+
+} // namespace
+
+int main()
+{
+    testOrdering();
+    testCapacity();
+    testErase();
+    testZeroCapacity();
+    return test::result("flat_map");
+}
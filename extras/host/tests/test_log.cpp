@@ -0,0 +1,49 @@
+// Log: messages above ARTNET_LOG_LEVEL are removed, and art_net::logging does not hide log() of <math.h>
+// even with using namespace art_net (as in the examples)
+
+#include "TestUtil.h"
+#include <Artnet/Log.h>
+#include <math.h>
+#include <string>
+
+using namespace art_net;
+
+namespace {
+
+struct StringPrint : public Print
+{
+    std::string text;
+
+    size_t write(uint8_t c) override
+    {
+        this->text += static_cast<char>(c);
+        return 1;
+    }
+};
+
+void testLevels()
+{
+    StringPrint out;
+    logging::error(&out).print("error ");
+    logging::warn(&out).println(42);
+    logging::info(&out).print("info");
+    logging::debug(&out).println(0x7F, HEX);
+#if ARTNET_LOG_LEVEL == ARTNET_LOG_LEVEL_WARN
+    CHECK(out.text == "error 42\r\n");
+#endif
+}
+
+void testMathLog()
+{
+    CHECK(log(1.0) == 0.0);
+    CHECK(::log(1.0) == 0.0);
+}
+
+} // namespace
+
+int main()
+{
+    testLevels();
+    testMathLog();
+    return test::result("log");
+}
@@ -0,0 +1,187 @@
+// PipelineReceiver: receive() and dispatch() on two threads while another thread subscribes and unsubscribes,
+// built with ThreadSanitizer (see CMakeLists.txt), and ArtPollReply rendered by dispatch() and sent by receive()
+
+#include "TestUtil.h"
+#include <Artnet/PipelineReceiver.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+using ArtnetLoopbackPipelineReceiver = art_net::PipelineReceiver<LoopbackUDP, 16>;
+
+constexpr uint16_t INPUT_PORT {16459};
+const IPAddress CONSOLE_IP(10, 4, 0, 1);
+
+size_t makeArtPoll(uint8_t *packet)
+{
+    memset(packet, 0, 14);
+    memcpy(packet, art_net::ARTNET_ID, sizeof(art_net::ARTNET_ID));
+    packet[art_net::art_dmx::OP_CODE_L] = static_cast<uint16_t>(art_net::OpCode::Poll) & 0x00FF;
+    packet[art_net::art_dmx::OP_CODE_H] = (static_cast<uint16_t>(art_net::OpCode::Poll) >> 8) & 0x00FF;
+    packet[art_net::art_dmx::PROTOCOL_VER_H] = (art_net::PROTOCOL_VER >> 8) & 0x00FF;
+    packet[art_net::art_dmx::PROTOCOL_VER_L] = (art_net::PROTOCOL_VER >> 0) & 0x00FF;
+    return 14;
+}
+
+struct Fixture
+{
+    art_net::host::LoopbackNetwork &network {art_net::host::loopbackNetwork()};
+    ArtnetLoopbackPipelineReceiver receiver;
+    LoopbackUDP console;
+    uint8_t packet[art_net::PACKET_SIZE];
+
+    Fixture()
+    {
+        this->network.useVirtualTime(true);
+        this->receiver.begin(INPUT_PORT);
+        this->console.setLocalIP(CONSOLE_IP);
+        this->console.begin(art_net::DEFAULT_PORT);
+    }
+    ~Fixture()
+    {
+        this->network.useVirtualTime(false);
+    }
+
+    void send(size_t size)
+    {
+        test::sendTo(this->console, art_net::host::LoopbackNetwork::broadcastIP(), INPUT_PORT, this->packet, size);
+    }
+
+    // universes of the ArtPollReply received by the console (sorted by the receiver)
+    std::vector<uint16_t> receivePollReplies()
+    {
+        std::vector<uint16_t> universes;
+        art_net::art_poll_reply::Packet reply;
+        while (this->console.parsePacket() > 0) {
+            const int size = this->console.read(reply.b, sizeof(reply.b));
+            if (size == static_cast<int>(sizeof(reply.b)) && reply.op_code_h == 0x21) {
+                universes.push_back(static_cast<uint16_t>((reply.net_sw << 8) | (reply.sub_sw << 4) | reply.sw_out[0]));
+            }
+        }
+        return universes;
+    }
+};
+
+void testPollReplyHandOver()
+{
+    Fixture f;
+    const auto noop = [](const uint8_t *, uint16_t, const ArtDmxMetadata &, const ArtNetRemoteInfo &) {};
+    f.receiver.subscribeArtDmxUniverse(1, noop);
+    f.receiver.subscribeArtDmxUniverse(0x123, noop);
+    f.send(makeArtPoll(f.packet));
+
+    // the read thread only moves the ArtPoll into the ring
+    CHECK(f.receiver.receive() == 1);
+    f.network.advanceUs(art_net::MAX_POLL_REPLY_DELAY_MS * 1000);
+    CHECK(f.receiver.receive() == 0);
+    CHECK(f.receivePollReplies().empty());
+
+    // scheduled by dispatch(), and rendered there when due
+    CHECK(f.receiver.dispatch() == 1);
+    CHECK(f.receiver.receive() == 0);
+    CHECK(f.receivePollReplies().empty());
+    f.network.advanceUs(art_net::MAX_POLL_REPLY_DELAY_MS * 1000);
+    f.receiver.update();
+    // universes at the time of rendering
+    f.receiver.unsubscribeArtDmxUniverse(1);
+    CHECK(f.receivePollReplies().empty());
+
+    // sent by the read thread
+    f.receiver.receive();
+    CHECK(f.receivePollReplies() == std::vector<uint16_t>({1, 0x123}));
+    CHECK(f.receiver.pollReplySendFailures() == 0);
+}
+
+void testThreads()
+{
+    Fixture f;
+    std::atomic<uint32_t> num_dmx {0};
+    f.receiver.subscribeArtDmxUniverse(1, [&](const uint8_t *data, uint16_t, const ArtDmxMetadata &, const ArtNetRemoteInfo &) {
+        num_dmx += data[0] == 42;
+        // rendering holds the snapshot for a while
+        const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(20);
+        while (std::chrono::steady_clock::now() < until) {
+        }
+    });
+
+    std::atomic<bool> running {true};
+    std::atomic<uint32_t> num_read {0};
+    std::thread reader([&] {
+        while (running) {
+            const size_t n = f.receiver.receive();
+            num_read += static_cast<uint32_t>(n);
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    std::thread dispatcher([&] {
+        while (running) {
+            if (f.receiver.dispatch() == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    // subscriptions are changed while dispatch() and ArtPollReply read them
+    std::atomic<uint32_t> num_churns {0};
+    std::thread churn([&] {
+        for (uint16_t i = 0; running; ++i) {
+            f.receiver.subscribeArtDmxUniverse(100 + i % 8, [](const uint8_t *, uint16_t, const ArtDmxMetadata &, const ArtNetRemoteInfo &) {});
+            f.receiver.unsubscribeArtDmxUniverse(100 + (i + 4) % 8);
+            ++num_churns;
+        }
+    });
+
+    const auto wait = [&](const std::function<bool()> &done) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!done() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    };
+
+    // ArtPoll every 1 s in virtual time, so that ArtPollReply reads the subscriptions while they are changed
+    size_t num_replies = 0;
+    uint32_t num_sent = 0;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        // keep the ring from overflowing so that all callbacks run
+        wait([&] { return num_sent - num_read + f.receiver.occupancy() < f.receiver.capacity() / 2; });
+        f.send(test::makeArtDmx(f.packet, 1, static_cast<uint8_t>(i), 42));
+        ++num_sent;
+        if (i % 10 == 0) {
+            f.send(makeArtPoll(f.packet));
+            ++num_sent;
+            f.network.advanceUs(art_net::MAX_POLL_REPLY_DELAY_MS * 1000);
+        }
+        num_replies += f.receivePollReplies().size();
+    }
+    // the last ArtPoll after the ring is drained (not dropped at the ring)
+    wait([&] { return num_read == num_sent && f.receiver.occupancy() == 0; });
+    f.send(makeArtPoll(f.packet));
+    const size_t num_replies_before_last = num_replies;
+    wait([&] {
+        f.network.advanceUs(10000);
+        num_replies += f.receivePollReplies().size();
+        return num_replies > num_replies_before_last && num_churns > 100;
+    });
+
+    running = false;
+    reader.join();
+    dispatcher.join();
+    churn.join();
+
+    CHECK(num_dmx == 2000);
+    CHECK(f.receiver.drops() == 0);
+    CHECK(num_replies > num_replies_before_last);
+    CHECK(f.receiver.pollReplySendFailures() == 0);
+}
+
+} // namespace
+
+int main()
+{
+    testPollReplyHandOver();
+    testThreads();
+    return test::result("pipeline_receiver");
+}
@@ -0,0 +1,176 @@
+// Router: ArtDmx / ArtNzs of the routed universes are forwarded with the universe and the sequence rewritten,
+// and the other datagrams are dispatched by the receiver, over LoopbackUDP
+
+#include "TestUtil.h"
+#include <Artnet/Router.h>
+
+namespace {
+
+using ArtnetLoopbackRouter = art_net::Router<ArtnetLoopbackReceiver, ArtnetLoopbackSender, 4>;
+
+constexpr uint16_t INPUT_PORT {16458};
+const IPAddress NODE_IP(10, 2, 0, 1);
+
+struct Fixture
+{
+    ArtnetLoopbackReceiver receiver;
+    ArtnetLoopbackSender sender;
+    ArtnetLoopbackRouter router;
+    LoopbackUDP console;
+    LoopbackUDP node;
+    uint8_t packet[art_net::PACKET_SIZE];
+    uint8_t forwarded[art_net::PACKET_SIZE];
+
+    Fixture()
+    : router(receiver, sender)
+    {
+        this->receiver.begin(INPUT_PORT);
+        this->sender.begin(0);
+        this->console.begin(0);
+        this->node.setLocalIP(NODE_IP);
+        this->node.begin(art_net::DEFAULT_PORT);
+    }
+
+    void send(size_t size)
+    {
+        test::sendTo(this->console, art_net::host::LoopbackNetwork::broadcastIP(), INPUT_PORT, this->packet, size);
+    }
+
+    void sendArtDmx(uint16_t universe, uint8_t sequence, uint8_t value)
+    {
+        this->send(test::makeArtDmx(this->packet, universe, sequence, value));
+    }
+
+    // the datagram received by the node (0 if none)
+    size_t receiveForwarded()
+    {
+        const int size = this->node.parsePacket();
+        if (size <= 0) {
+            return 0;
+        }
+        return static_cast<size_t>(this->node.read(this->forwarded, sizeof(this->forwarded)));
+    }
+
+    uint16_t forwardedUniverse() const
+    {
+        return static_cast<uint16_t>(((this->forwarded[art_net::art_dmx::NET] & 0x7F) << 8) | this->forwarded[art_net::art_dmx::SUBUNI]);
+    }
+};
+
+void testHeaderRewrite()
+{
+    Fixture f;
+    CHECK(f.router.addRoute(1, NODE_IP.toString(), 0x1234));
+    f.sendArtDmx(1, 77, 42);
+    CHECK(f.router.route() == 1);
+    const size_t size = f.receiveForwarded();
+    // the same datagram, only the universe and the sequence differ
+    CHECK(size == art_net::HEADER_SIZE + 512);
+    CHECK(f.forwardedUniverse() == 0x1234);
+    CHECK(f.forwarded[art_net::art_dmx::SEQUENCE] == 1);
+    f.packet[art_net::art_dmx::SEQUENCE] = 1;
+    f.packet[art_net::art_dmx::NET] = 0x12;
+    f.packet[art_net::art_dmx::SUBUNI] = 0x34;
+    CHECK(size > 0 && memcmp(f.packet, f.forwarded, size) == 0);
+
+    const art_net::RouteStats *stats = f.router.routeStats(1);
+    CHECK(stats != nullptr && stats->forwarded == 1 && stats->bytes == size && stats->send_failures == 0);
+    CHECK(f.router.routeStats(2) == nullptr);
+    CHECK(f.router.localPackets() == 0);
+
+    // ArtNzs has the same layout
+    test::makeArtDmx(f.packet, 1, 5, 7, 64);
+    f.packet[art_net::art_dmx::OP_CODE_L] = static_cast<uint16_t>(art_net::OpCode::Nzs) & 0x00FF;
+    f.packet[art_net::art_dmx::OP_CODE_H] = (static_cast<uint16_t>(art_net::OpCode::Nzs) >> 8) & 0x00FF;
+    f.send(art_net::HEADER_SIZE + 64);
+    f.router.route();
+    CHECK(f.receiveForwarded() == art_net::HEADER_SIZE + 64);
+    CHECK(f.forwarded[art_net::art_dmx::OP_CODE_H] == 0x51);
+    CHECK(f.forwardedUniverse() == 0x1234);
+    CHECK(f.forwarded[art_net::art_dmx::SEQUENCE] == 2);
+}
+
+void testSequencePerRoute()
+{
+    Fixture f;
+    CHECK(f.router.addRoute(1, NODE_IP.toString(), 10));
+    CHECK(f.router.addRoute(2, NODE_IP.toString(), 20));
+    // the sequence of the source is replaced by the own count of each route, which wraps to 1 (0 is "disabled")
+    bool counted = true;
+    for (uint32_t i = 1; i <= 300; ++i) {
+        f.sendArtDmx(1, 200, 0);
+        f.router.route();
+        counted &= f.receiveForwarded() > 0 && f.forwarded[art_net::art_dmx::SEQUENCE] == (i - 1) % 255 + 1;
+    }
+    CHECK(counted);
+    f.sendArtDmx(2, 200, 0);
+    f.router.route();
+    CHECK(f.receiveForwarded() > 0 && f.forwardedUniverse() == 20 && f.forwarded[art_net::art_dmx::SEQUENCE] == 1);
+
+    // kept 0 if the source disabled the sequence
+    f.sendArtDmx(2, 0, 0);
+    f.router.route();
+    CHECK(f.receiveForwarded() > 0 && f.forwarded[art_net::art_dmx::SEQUENCE] == 0);
+    CHECK(f.router.routeStats(1)->forwarded == 300);
+}
+
+void testLocalDispatch()
+{
+    Fixture f;
+    CHECK(f.router.addRoute(1, NODE_IP.toString()));
+    uint32_t num_local_dmx = 0;
+    uint32_t num_syncs = 0;
+    f.receiver.subscribeArtDmxUniverse(5, [&](const uint8_t *data, uint16_t, const ArtDmxMetadata &, const ArtNetRemoteInfo &) {
+        num_local_dmx += data[0] == 9;
+    });
+    f.receiver.subscribeArtSync([&](const ArtNetRemoteInfo &) {
+        ++num_syncs;
+    });
+
+    // unrouted universes and other op codes go to the receiver, and are not forwarded
+    f.sendArtDmx(5, 1, 9);
+    f.send(test::makeArtSync(f.packet));
+    CHECK(f.router.route() == 2);
+    CHECK(num_local_dmx == 1);
+    CHECK(num_syncs == 1);
+    CHECK(f.router.localPackets() == 2);
+    CHECK(f.receiveForwarded() == 0);
+
+    // after the route is removed, the universe is dispatched locally
+    f.router.removeRoute(1);
+    CHECK(f.router.numRoutes() == 0);
+    f.sendArtDmx(1, 1, 0);
+    f.router.route();
+    CHECK(f.receiveForwarded() == 0);
+    CHECK(f.router.localPackets() == 3);
+
+    f.router.resetRouteStats();
+    CHECK(f.router.localPackets() == 0);
+}
+
+void testCapacity()
+{
+    Fixture f;
+    bool added = true;
+    for (uint16_t u = 0; u < 4; ++u) {
+        added &= f.router.addRoute(u, NODE_IP.toString());
+    }
+    CHECK(added);
+    CHECK(!f.router.addRoute(4, NODE_IP.toString()));
+    // an existing route can still be replaced when full
+    CHECK(f.router.addRoute(3, NODE_IP.toString(), 100));
+    f.sendArtDmx(3, 1, 0);
+    f.router.route();
+    CHECK(f.receiveForwarded() > 0 && f.forwardedUniverse() == 100);
+}
+
+} // namespace
+
+int main()
+{
+    testHeaderRewrite();
+    testSequencePerRoute();
+    testLocalDispatch();
+    testCapacity();
+    return test::result("router");
+}
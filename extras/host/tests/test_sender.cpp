@@ -0,0 +1,88 @@
+// Sender_: sequences per destination in the fixed size destination table, and the behaviour when it is full
+
+#include "TestUtil.h"
+
+namespace {
+
+const IPAddress NODE_IP(10, 3, 0, 1);
+
+struct Fixture
+{
+    art_net::Sender<LoopbackUDP, 2> sender;
+    LoopbackUDP node;
+    uint8_t data[512] {};
+    uint8_t received[art_net::PACKET_SIZE];
+
+    Fixture()
+    {
+        this->sender.begin(0);
+        this->node.setLocalIP(NODE_IP);
+        this->node.begin(art_net::DEFAULT_PORT);
+    }
+
+    // sequence of the received ArtDmx (-1 if none)
+    int receivedSequence()
+    {
+        if (this->node.parsePacket() <= 0) {
+            return -1;
+        }
+        this->node.read(this->received, sizeof(this->received));
+        return this->received[art_net::art_dmx::SEQUENCE];
+    }
+};
+
+void testSequencePerDestination()
+{
+    Fixture f;
+    const String ip = NODE_IP.toString();
+    f.sender.sendArtDmx(ip, 1, f.data, sizeof(f.data));
+    f.sender.sendArtDmx(ip, 1, f.data, sizeof(f.data));
+    f.sender.sendArtDmx(ip, 2, f.data, sizeof(f.data));
+    f.sender.sendArtDmx(ip, 1, f.data, sizeof(f.data));
+    CHECK(f.receivedSequence() == 0);
+    CHECK(f.receivedSequence() == 1);
+    CHECK(f.receivedSequence() == 0);
+    CHECK(f.receivedSequence() == 2);
+}
+
+void testFullTable()
+{
+    Fixture f;
+    const String ip = NODE_IP.toString();
+    f.sender.sendArtDmx(ip, 1, f.data, sizeof(f.data));
+    f.sender.sendArtDmx(ip, 2, f.data, sizeof(f.data));
+    // the third destination is sent without sequence, and not streamed
+    f.sender.sendArtDmx(ip, 3, f.data, sizeof(f.data));
+    f.sender.sendArtDmx(ip, 3, f.data, sizeof(f.data));
+    f.sender.setArtDmxData(f.data, sizeof(f.data));
+    f.sender.streamArtDmxTo(ip, 3);
+    CHECK(f.receivedSequence() == 0);
+    CHECK(f.receivedSequence() == 0);
+    CHECK(f.receivedSequence() == 0);
+    CHECK(f.receivedSequence() == 0);
+    CHECK(f.receivedSequence() == -1);
+    // the registered ones keep counting
+    f.sender.sendArtDmx(ip, 1, f.data, sizeof(f.data));
+    CHECK(f.receivedSequence() == 1);
+}
+
+void testLongIp()
+{
+    // longer than an IPv4 address (e.g. a host name): not registered, sent without sequence
+    Fixture f;
+    f.sender.sendArtDmx("10.3.0.1.invalid", 1, f.data, sizeof(f.data));
+    f.sender.sendArtDmx(NODE_IP.toString(), 1, f.data, sizeof(f.data));
+    f.sender.sendArtDmx(NODE_IP.toString(), 1, f.data, sizeof(f.data));
+    CHECK(f.receivedSequence() == 0);
+    CHECK(f.receivedSequence() == 1);
+}
+
+} // namespace
+
+int main()
+{
+    testSequencePerDestination();
+    testFullTable();
+    testLongIp();
+    return test::result("sender");
+}
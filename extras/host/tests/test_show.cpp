@@ -0,0 +1,222 @@
+// Show file: delta encode / decode round trip, key frame seeking (also without the index),
+// and playback through Sender_ to Receiver_ over LoopbackUDP in virtual time
+
+#include "TestUtil.h"
+#include <cstdio>
+#include <map>
+#include <vector>
+
+namespace {
+
+using art_net::host::ShowFrame;
+using art_net::host::ShowPlayer;
+using art_net::host::ShowReader;
+using art_net::host::ShowRecorder;
+namespace show = art_net::host::show;
+
+constexpr uint16_t NUM_UNIVERSES {3};
+constexpr uint32_t NUM_FRAMES {250};     // 10 seconds
+constexpr uint32_t FRAME_US {40000};     // 25 fps
+constexpr uint32_t KEY_FRAME_MS {1000};  // a key frame every 25 frames
+const char *const PATH = "test_show.show";
+
+// frame i of the universe: a few bytes change from the previous frame
+void frameData(uint16_t universe, uint32_t i, uint8_t *data)
+{
+    memset(data, static_cast<int>(universe * 10), 512);
+    data[0] = static_cast<uint8_t>(i);
+    data[(7 * i) % 512] = static_cast<uint8_t>(3 * i);
+}
+
+bool isFrame(const uint8_t *data, uint16_t size, uint16_t universe, uint32_t i)
+{
+    uint8_t expected[512];
+    frameData(universe, i, expected);
+    return size == 512 && memcmp(data, expected, 512) == 0;
+}
+
+void record(ShowRecorder &recorder)
+{
+    uint8_t data[512];
+    for (uint32_t i = 0; i < NUM_FRAMES; ++i) {
+        for (uint16_t u = 1; u <= NUM_UNIVERSES; ++u) {
+            frameData(u, i, data);
+            recorder.recordArtDmx(static_cast<uint64_t>(i) * FRAME_US, u, data, sizeof(data));
+        }
+        recorder.recordArtSync(static_cast<uint64_t>(i) * FRAME_US);
+    }
+}
+
+// read all records from the current position, returns false if any frame is not the recorded one
+bool readAll(ShowReader &reader, uint32_t &num_frames, uint32_t &num_syncs, uint64_t &first_time_us)
+{
+    bool all_match = true;
+    num_frames = 0;
+    num_syncs = 0;
+    first_time_us = UINT64_MAX;
+    ShowFrame frame;
+    while (reader.next(frame)) {
+        if (frame.type == show::RecordType::Full) {
+            all_match &= frame.time_us % FRAME_US == 0 && isFrame(frame.data, frame.size, frame.universe, static_cast<uint32_t>(frame.time_us / FRAME_US));
+            ++num_frames;
+            if (first_time_us == UINT64_MAX) {
+                first_time_us = frame.time_us;
+            }
+        } else if (frame.type == show::RecordType::Sync) {
+            ++num_syncs;
+        }
+    }
+    return all_match;
+}
+
+void testRoundTrip()
+{
+    ShowRecorder recorder;
+    CHECK(recorder.open(PATH, KEY_FRAME_MS));
+    record(recorder);
+    // only the changed bytes are written after the first frame
+    CHECK(recorder.bytesWritten() < NUM_FRAMES * NUM_UNIVERSES * 512 / 4);
+    recorder.close();
+    CHECK(!recorder.hasError());
+
+    ShowReader reader;
+    CHECK(reader.open(PATH));
+    CHECK(reader.durationUs() == static_cast<uint64_t>(NUM_FRAMES - 1) * FRAME_US);
+    CHECK(reader.keyFrameIntervalMs() == KEY_FRAME_MS);
+    CHECK(reader.numKeyFrames() == NUM_FRAMES * FRAME_US / (KEY_FRAME_MS * 1000));
+    uint32_t num_frames = 0;
+    uint32_t num_syncs = 0;
+    uint64_t first_time_us = 0;
+    CHECK(readAll(reader, num_frames, num_syncs, first_time_us));
+    CHECK(num_frames == NUM_FRAMES * NUM_UNIVERSES);
+    CHECK(num_syncs == NUM_FRAMES);
+
+    // rewind and read again
+    reader.rewind();
+    CHECK(readAll(reader, num_frames, num_syncs, first_time_us));
+    CHECK(num_frames == NUM_FRAMES * NUM_UNIVERSES && first_time_us == 0);
+}
+
+void testSeek()
+{
+    ShowReader reader;
+    CHECK(reader.open(PATH));
+    // the key frame restores all universes, so the deltas after it are decoded correctly
+    CHECK(reader.seekKeyFrame(5500000) == 5000000);
+    uint32_t num_frames = 0;
+    uint32_t num_syncs = 0;
+    uint64_t first_time_us = 0;
+    CHECK(readAll(reader, num_frames, num_syncs, first_time_us));
+    CHECK(first_time_us == 5000000);
+    CHECK(num_frames == (NUM_FRAMES - 125) * NUM_UNIVERSES);
+
+    CHECK(reader.seekKeyFrame(0) == 0);
+    CHECK(reader.seekKeyFrame(UINT64_MAX) == 9000000);
+}
+
+void testUnclosedRecording()
+{
+    // a recording which was not closed has no index: key frames are found by scanning
+    ShowRecorder recorder;
+    CHECK(recorder.open(PATH, KEY_FRAME_MS));
+    record(recorder);
+    recorder.flush();
+
+    ShowReader reader;
+    CHECK(reader.open(PATH));
+    CHECK(reader.numKeyFrames() == NUM_FRAMES * FRAME_US / (KEY_FRAME_MS * 1000));
+    CHECK(reader.seekKeyFrame(3000000) == 3000000);
+    uint32_t num_frames = 0;
+    uint32_t num_syncs = 0;
+    uint64_t first_time_us = 0;
+    CHECK(readAll(reader, num_frames, num_syncs, first_time_us));
+    CHECK(num_frames == (NUM_FRAMES - 75) * NUM_UNIVERSES);
+    recorder.close();
+}
+
+void testPlayer()
+{
+    ShowRecorder recorder;
+    CHECK(recorder.open(PATH, KEY_FRAME_MS));
+    record(recorder);
+    recorder.close();
+
+    art_net::host::LoopbackNetwork &network = art_net::host::loopbackNetwork();
+    network.useVirtualTime(true);
+
+    ArtnetLoopbackReceiver receiver;
+    receiver.begin();
+    std::map<uint16_t, std::vector<uint8_t>> last;
+    uint32_t num_syncs = 0;
+    receiver.subscribeArtDmx([&](const uint8_t *data, uint16_t size, const ArtDmxMetadata &metadata, const ArtNetRemoteInfo &) {
+        last[test::universeOf(metadata)].assign(data, data + size);
+    });
+    receiver.subscribeArtSync([&](const ArtNetRemoteInfo &) {
+        ++num_syncs;
+    });
+    ArtnetLoopbackSender sender;
+    sender.begin(0);
+
+    ShowPlayer player;
+    CHECK(player.open(PATH));
+    player.setDestination(art_net::host::LoopbackNetwork::broadcastIP().toString());
+    player.seek(5000000);
+    player.play();
+    // the frames of all universes at the position are sent first
+    CHECK(player.update(sender) > 0);
+    while (receiver.parse() != art_net::OpCode::NoPacket) {
+    }
+    bool at_125 = last.size() == NUM_UNIVERSES;
+    for (const auto &u : last) {
+        at_125 &= isFrame(u.second.data(), static_cast<uint16_t>(u.second.size()), u.first, 125);
+    }
+    CHECK(at_125);
+    CHECK(num_syncs == 1);
+    CHECK(player.nextDueUs() == FRAME_US);
+
+    // one second later in virtual time
+    network.advanceUs(1000000);
+    player.update(sender);
+    while (receiver.parse() != art_net::OpCode::NoPacket) {
+    }
+    bool at_150 = last.size() == NUM_UNIVERSES;
+    for (const auto &u : last) {
+        at_150 &= isFrame(u.second.data(), static_cast<uint16_t>(u.second.size()), u.first, 150);
+    }
+    CHECK(at_150);
+    CHECK(num_syncs == 26);
+    CHECK(player.positionUs() == 6000000);
+
+    // between two frames: only the frames at the position, the next ones are not sent before they are due
+    player.seek(5020000);
+    last.clear();
+    num_syncs = 0;
+    CHECK(player.update(sender) == NUM_UNIVERSES);
+    while (receiver.parse() != art_net::OpCode::NoPacket) {
+    }
+    bool at_125_again = last.size() == NUM_UNIVERSES;
+    for (const auto &u : last) {
+        at_125_again &= isFrame(u.second.data(), static_cast<uint16_t>(u.second.size()), u.first, 125);
+    }
+    CHECK(at_125_again);
+    CHECK(num_syncs == 0);
+    CHECK(player.nextDueUs() == FRAME_US / 2);
+
+    // to the end
+    network.advanceUs(5000000);
+    player.update(sender);
+    CHECK(!player.isPlaying());
+    network.useVirtualTime(false);
+}
+
+} // namespace
+
+int main()
+{
+    testRoundTrip();
+    testSeek();
+    testUnclosedRecording();
+    testPlayer();
+    std::remove(PATH);
+    return test::result("show");
+}
@@ -0,0 +1,198 @@
+// SnapshotTable: the snapshot held by the reader is never modified, updates are published after release(),
+// synchronize() waits for the reader, and callbacks are shared (not copied) between the snapshots
+
+#include "TestUtil.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using art_net::SnapshotCallback;
+using art_net::SnapshotReader;
+using art_net::SnapshotTable;
+
+struct Pair
+{
+    uint32_t a {0};
+    uint32_t b {0};
+};
+
+void testReaderKeepsSnapshot()
+{
+    SnapshotTable<Pair> table;
+    {
+        SnapshotReader<Pair> reader(table);
+        CHECK(reader->a == 0);
+        // updates while the reader holds the snapshot (e.g. from a callback) go to the other buffers
+        for (uint32_t i = 1; i <= 5; ++i) {
+            table.update([i](Pair &p) {
+                p.a = i;
+                p.b = i;
+            });
+            CHECK(reader->a == 0 && reader->b == 0);
+        }
+    }
+    SnapshotReader<Pair> reader(table);
+    CHECK(reader->a == 5 && reader->b == 5);
+}
+
+void testUpdateReturnsValue()
+{
+    SnapshotTable<Pair> table;
+    const bool updated = table.update([](Pair &p) {
+        p.a = 1;
+        return true;
+    });
+    CHECK(updated);
+    // each update starts from a copy of the latest snapshot
+    const uint32_t b = table.update([](Pair &p) {
+        p.b = p.a + 1;
+        return p.b;
+    });
+    CHECK(b == 2);
+    SnapshotReader<Pair> reader(table);
+    CHECK(reader->a == 1 && reader->b == 2);
+}
+
+void testConcurrentWriters()
+{
+    constexpr uint32_t NUM_WRITERS {3};
+    constexpr uint32_t UPDATES_PER_WRITER {20000};
+    SnapshotTable<Pair> table;
+    std::atomic<bool> done {false};
+    std::atomic<uint32_t> torn {0};
+
+    std::thread reader_thread([&] {
+        uint32_t last = 0;
+        while (!done) {
+            SnapshotReader<Pair> reader(table);
+            const uint32_t a = reader->a;
+            // a half written snapshot or going backwards means the reader saw a buffer being updated
+            if (a != reader->b || a < last) {
+                ++torn;
+            }
+            last = a;
+        }
+    });
+    std::vector<std::thread> writers;
+    for (uint32_t w = 0; w < NUM_WRITERS; ++w) {
+        writers.emplace_back([&] {
+            for (uint32_t i = 0; i < UPDATES_PER_WRITER; ++i) {
+                table.update([](Pair &p) {
+                    ++p.a;
+                    ++p.b;
+                });
+            }
+        });
+    }
+    for (auto &w : writers) {
+        w.join();
+    }
+    done = true;
+    reader_thread.join();
+
+    CHECK(torn == 0);
+    SnapshotReader<Pair> reader(table);
+    CHECK(reader->a == NUM_WRITERS * UPDATES_PER_WRITER);
+    CHECK(reader->b == NUM_WRITERS * UPDATES_PER_WRITER);
+}
+
+void testSynchronize()
+{
+    SnapshotTable<Pair> table;
+    std::atomic<bool> holding {false};
+    std::atomic<bool> release {false};
+    std::thread reader_thread([&] {
+        SnapshotReader<Pair> reader(table);
+        // the reader can update and synchronize in its callbacks without waiting for itself
+        table.update([](Pair &p) {
+            p.a = 1;
+        });
+        table.synchronize();
+        holding = true;
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+    while (!holding) {
+        std::this_thread::yield();
+    }
+
+    // the reader still holds the snapshot before the update
+    std::atomic<bool> synchronized {false};
+    std::thread writer_thread([&] {
+        table.synchronize();
+        synchronized = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(!synchronized);
+    release = true;
+    writer_thread.join();
+    reader_thread.join();
+    CHECK(synchronized);
+
+    // nothing is held
+    table.synchronize();
+}
+
+// callable which counts its copies
+struct Counted
+{
+    std::shared_ptr<uint32_t> copies;
+    Counted(const std::shared_ptr<uint32_t> &c) : copies(c) {}
+    Counted(const Counted &other) : copies(other.copies) { ++*this->copies; }
+    void operator()() const {}
+};
+
+struct Callbacks
+{
+    SnapshotCallback<std::function<void()>> cb;
+    uint32_t n {0};
+};
+
+void testSharedCallback()
+{
+    SnapshotTable<Callbacks> table;
+    auto copies = std::make_shared<uint32_t>(0);
+    table.update([&](Callbacks &c) {
+        c.cb = std::function<void()>(Counted(copies));
+    });
+    const uint32_t copies_on_subscribe = *copies;
+    // other updates copy the table, but not the callable
+    for (uint32_t i = 0; i < 5; ++i) {
+        table.update([](Callbacks &c) {
+            ++c.n;
+        });
+    }
+    CHECK(*copies == copies_on_subscribe);
+    {
+        SnapshotReader<Callbacks> reader(table);
+        CHECK(static_cast<bool>(reader->cb));
+        reader->cb();
+    }
+
+    // destroyed after all the snapshots which have it are overwritten
+    table.update([](Callbacks &c) {
+        c.cb = nullptr;
+    });
+    CHECK(copies.use_count() > 1);
+    table.update([](Callbacks &) {});
+    table.update([](Callbacks &) {});
+    CHECK(copies.use_count() == 1);
+}
+
+} // namespace
+
+int main()
+{
+    testReaderKeepsSnapshot();
+    testUpdateReturnsValue();
+    testConcurrentWriters();
+    testSynchronize();
+    testSharedCallback();
+    return test::result("snapshot_table");
+}
@@ -0,0 +1,107 @@
+// SourceFilter: deny / allow lists and their drop counters, alone and in Receiver over LoopbackUDP
+
+#include "TestUtil.h"
+
+namespace {
+
+using art_net::SourceFilter;
+using art_net::SourceFilterResult;
+
+const IPAddress CONSOLE_A(10, 1, 0, 1);
+const IPAddress CONSOLE_B(10, 1, 0, 2);
+const IPAddress CONSOLE_C(10, 1, 0, 3);
+
+void testDenyList()
+{
+    SourceFilter<4> filter;
+    CHECK(filter.check(CONSOLE_A) == SourceFilterResult::Accepted);
+    CHECK(filter.deny(CONSOLE_A));
+    CHECK(filter.check(CONSOLE_A) == SourceFilterResult::Denied);
+    CHECK(filter.check(CONSOLE_B) == SourceFilterResult::Accepted);
+    CHECK(filter.drops().denied == 1 && filter.drops().not_allowed == 0);
+    // lookup() does not count
+    CHECK(filter.lookup(CONSOLE_A) == SourceFilterResult::Denied);
+    CHECK(filter.drops().denied == 1);
+    filter.remove(CONSOLE_A);
+    CHECK(filter.check(CONSOLE_A) == SourceFilterResult::Accepted);
+    filter.resetDrops();
+    CHECK(filter.drops().denied == 0);
+}
+
+void testAllowList()
+{
+    SourceFilter<4> filter;
+    CHECK(filter.allow(CONSOLE_A));
+    CHECK(filter.check(CONSOLE_A) == SourceFilterResult::Accepted);
+    CHECK(filter.check(CONSOLE_B) == SourceFilterResult::NotAllowed);
+    CHECK(filter.drops().not_allowed == 1);
+    // changing the entry to deny also removes it from the allow list, so the others are accepted again
+    CHECK(filter.deny(CONSOLE_A));
+    CHECK(filter.check(CONSOLE_A) == SourceFilterResult::Denied);
+    CHECK(filter.check(CONSOLE_B) == SourceFilterResult::Accepted);
+    filter.clear();
+    CHECK(filter.empty());
+    CHECK(filter.check(CONSOLE_A) == SourceFilterResult::Accepted);
+}
+
+void testCapacity()
+{
+    SourceFilter<2> filter;
+    CHECK(filter.deny(CONSOLE_A) && filter.deny(CONSOLE_B));
+    CHECK(!filter.deny(CONSOLE_C));
+    CHECK(filter.check(CONSOLE_C) == SourceFilterResult::Accepted);
+    // an existing entry can still be changed when full
+    CHECK(filter.allow(CONSOLE_B));
+    CHECK(filter.check(CONSOLE_C) == SourceFilterResult::NotAllowed);
+}
+
+void testReceiver()
+{
+    ArtnetLoopbackReceiver receiver;
+    receiver.begin(16457);
+    LoopbackUDP console_a;
+    LoopbackUDP console_b;
+    console_a.setLocalIP(CONSOLE_A);
+    console_b.setLocalIP(CONSOLE_B);
+    console_a.begin(0);
+    console_b.begin(0);
+    uint32_t num_dmx = 0;
+    receiver.subscribeArtDmxUniverse(1, [&](const uint8_t *, uint16_t, const ArtDmxMetadata &, const ArtNetRemoteInfo &) {
+        ++num_dmx;
+    });
+
+    uint8_t packet[art_net::PACKET_SIZE];
+    const size_t size = test::makeArtDmx(packet, 1, 0, 0);
+    const IPAddress dst = art_net::host::LoopbackNetwork::broadcastIP();
+
+    receiver.denySource(CONSOLE_A);
+    test::sendTo(console_a, dst, 16457, packet, size);
+    CHECK(receiver.parse() == art_net::OpCode::Filtered);
+    test::sendTo(console_b, dst, 16457, packet, size);
+    CHECK(receiver.parse() == art_net::OpCode::Dmx);
+    CHECK(num_dmx == 1);
+    CHECK(receiver.sourceFilterDrops().denied == 1);
+#if ARTNET_ENABLE_STATS
+    CHECK(receiver.receiverStats().drops.filtered == 1);
+#endif
+
+    receiver.clearSourceFilters();
+    receiver.allowSource(CONSOLE_A);
+    test::sendTo(console_b, dst, 16457, packet, size);
+    CHECK(receiver.parse() == art_net::OpCode::Filtered);
+    test::sendTo(console_a, dst, 16457, packet, size);
+    CHECK(receiver.parse() == art_net::OpCode::Dmx);
+    CHECK(num_dmx == 2);
+    CHECK(receiver.sourceFilterDrops().not_allowed == 1);
+}
+
+} // namespace
+
+int main()
+{
+    testDenyList();
+    testAllowList();
+    testCapacity();
+    testReceiver();
+    return test::result("source_filter");
+}
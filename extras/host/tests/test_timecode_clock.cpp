@@ -0,0 +1,133 @@
+// ArtTimeCode frame math (including drop frame) and the lock / pause / jump / timeout behaviour of TimeCodeClock
+
+#include "TestUtil.h"
+#include <Artnet/TimeCodeClock.h>
+
+namespace {
+
+namespace tc = art_net::art_timecode;
+
+ArtTimeCodeMetadata timecode(uint8_t h, uint8_t m, uint8_t s, uint8_t f, tc::Type type)
+{
+    ArtTimeCodeMetadata t;
+    t.hours = h;
+    t.minutes = m;
+    t.seconds = s;
+    t.frames = f;
+    t.type = type;
+    t.stream_id = 0;
+    return t;
+}
+
+void testDropFrameMath()
+{
+    // frames 0 and 1 are skipped at each minute except every 10th
+    CHECK(tc::toFrameCount(timecode(0, 0, 59, 29, tc::Type::DropFrame)) == 1799);
+    CHECK(tc::toFrameCount(timecode(0, 1, 0, 2, tc::Type::DropFrame)) == 1800);
+    CHECK(tc::toFrameCount(timecode(0, 10, 0, 0, tc::Type::DropFrame)) == 17982);
+    CHECK(tc::toFrameCount(timecode(1, 0, 0, 0, tc::Type::DropFrame)) == 6 * 17982);
+
+    bool round_trip = true;
+    bool no_dropped_labels = true;
+    for (uint32_t count = 0; count < 3 * 17982; ++count) {
+        const ArtTimeCodeMetadata t = tc::fromFrameCount(count, tc::Type::DropFrame);
+        round_trip &= tc::isValid(t) && tc::toFrameCount(t) == count;
+        no_dropped_labels &= !(t.seconds == 0 && t.frames < 2 && t.minutes % 10 != 0);
+    }
+    CHECK(round_trip);
+    CHECK(no_dropped_labels);
+
+    // 29.97 fps: 30 frames take 1.001 seconds
+    CHECK(tc::framesToMicros(30, tc::Type::DropFrame) == 1001000);
+    CHECK(tc::framesToMicros(25, tc::Type::EBU) == 1000000);
+    bool micros_round_trip = true;
+    for (uint8_t type = 0; type < 4; ++type) {
+        for (uint32_t frames = 0; frames < 5000; ++frames) {
+            micros_round_trip &= tc::microsToFrames(tc::framesToMicros(frames, static_cast<tc::Type>(type)), static_cast<tc::Type>(type)) == frames;
+        }
+    }
+    CHECK(micros_round_trip);
+}
+
+// feed EBU (25 fps) timecodes from frame `start`, one every `interval_us` of the local clock
+uint32_t feed(ArtTimeCodeClock &clock, uint32_t start, uint32_t num_frames, uint32_t local_us, uint32_t interval_us)
+{
+    for (uint32_t i = 0; i < num_frames; ++i) {
+        clock.update(tc::fromFrameCount(start + i, tc::Type::EBU), local_us);
+        local_us += interval_us;
+    }
+    return local_us - interval_us;
+}
+
+void testLockAndFreewheel()
+{
+    ArtTimeCodeClock clock;
+    CHECK(!clock.isLocked());
+    const uint32_t last_us = feed(clock, 250, 50, 1000000, 40000);
+    CHECK(clock.isLocked());
+    CHECK(clock.type() == tc::Type::EBU);
+    CHECK(clock.isRunning(last_us + 1000));
+    // between packets the position advances with the local clock
+    CHECK(clock.frameCountAt(last_us) == 299);
+    CHECK(clock.positionUs(last_us + 20000) == tc::framesToMicros(299, tc::Type::EBU) + 20000);
+    CHECK(clock.frameCountAt(last_us + 40000) == 300);
+    const ArtTimeCodeMetadata t = clock.timeCodeAt(last_us);
+    CHECK(t.seconds == 11 && t.frames == 24);
+    CHECK(clock.microsToNextFrame(last_us + 10000) == 30000);
+}
+
+void testPauseJumpAndTimeout()
+{
+    ArtTimeCodeClock clock;
+    clock.setTimeoutMs(500);
+    uint32_t now = feed(clock, 0, 25, 0, 40000);
+
+    // same timecode repeated: paused, the position holds
+    clock.update(tc::fromFrameCount(24, tc::Type::EBU), now + 40000);
+    clock.update(tc::fromFrameCount(24, tc::Type::EBU), now + 80000);
+    CHECK(!clock.isRunning(now + 80000));
+    CHECK(clock.frameCountAt(now + 200000) == 24);
+
+    // resume after pause and jump (locate) lock to the received timecode immediately
+    now = feed(clock, 1000, 3, now + 120000, 40000);
+    CHECK(clock.frameCountAt(now) == 1002);
+    clock.update(tc::fromFrameCount(5000, tc::Type::EBU), now + 40000);
+    CHECK(clock.frameCountAt(now + 40000) == 5000);
+    now += 40000;
+
+    // no packet for the timeout: freewheel until the timeout, then hold
+    CHECK(clock.isRunning(now + 400000));
+    CHECK(!clock.isRunning(now + 600000));
+    CHECK(clock.positionUs(now + 2000000) == tc::framesToMicros(5000, tc::Type::EBU) + 500000);
+
+    // change of the type locks to the new type
+    clock.update(tc::fromFrameCount(100, tc::Type::SMPTE), now + 700000);
+    CHECK(clock.type() == tc::Type::SMPTE);
+    CHECK(clock.frameCountAt(now + 700000) == 100);
+
+    clock.reset();
+    CHECK(!clock.isLocked());
+}
+
+void testDrift()
+{
+    // the console clock runs 1% faster than the local clock (a frame every 39600 us instead of 40000 us)
+    ArtTimeCodeClock clock;
+    const uint32_t last_us = feed(clock, 0, 2000, 0, 39600);
+    CHECK(clock.driftPpm() > 5000 && clock.driftPpm() < 15000);
+    // the prediction follows the console between packets
+    const int64_t predicted = static_cast<int64_t>(clock.positionUs(last_us + 39600));
+    const int64_t expected = static_cast<int64_t>(tc::framesToMicros(2000, tc::Type::EBU));
+    CHECK(predicted > expected - 2000 && predicted < expected + 2000);
+}
+
+} // namespace
+
+int main()
+{
+    testDropFrameMath();
+    testLockAndFreewheel();
+    testPauseJumpAndTimeout();
+    testDrift();
+    return test::result("timecode_clock");
+}